@@ -0,0 +1,596 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "BenchRunner.h"
+
+#include "Helper.h"
+#include "Collision.h"
+#include "GameFilesystem.h"
+#include "GameFilesystemGen.h"
+#include "DungeonGen.h"
+#include "World.h"
+#include "Player.h"
+
+/**
+* Plain world ent used to fill areas for the entity query benchmarks.
+*/
+class BenchPropEntity : public WorldEntity
+{
+public:
+    BenchPropEntity() { }
+    virtual ~BenchPropEntity() { }
+
+    inline virtual const char* GetName() const override { return "BenchPropEntity"; }
+};
+
+/**
+* Unit ent used to benchmark queries filtered to a subclass.
+*/
+class BenchUnitEntity : public UnitEntity
+{
+public:
+    BenchUnitEntity() { }
+    virtual ~BenchUnitEntity() { }
+
+    inline virtual std::string GetUnitName() const override { return "Bench Unit"; }
+    inline virtual const char* GetName() const override { return "BenchUnitEntity"; }
+};
+
+
+namespace
+{
+    const u32 AreaSize = 200;
+
+    sf::Vector2f GenerateRandomAreaPosition(Rng& rng)
+    {
+        return sf::Vector2f(
+            Helper::GenerateRandomReal(rng, 0.0f, AreaSize * BaseTile::TileSize.x),
+            Helper::GenerateRandomReal(rng, 0.0f, AreaSize * BaseTile::TileSize.y)
+            );
+    }
+
+
+    void CollectNodes(GameFilesystemNode& node, std::vector<GameFilesystemNode*>& outNodes)
+    {
+        outNodes.emplace_back(&node);
+
+        for (std::size_t i = 0; i < node.GetChildrenCount(); ++i) {
+            auto child = node.GetChildNode(i);
+            if (child) {
+                CollectNodes(*child, outNodes);
+            }
+        }
+    }
+
+
+    void BenchTileCollision(BenchRunner& runner, Rng& rng, GameFilesystem& fs)
+    {
+        if (runner.IsFiltered("WorldArea::TryCollisionRectMove") && runner.IsFiltered("WorldArea::TryCollisionRectMoveFixed") &&
+            runner.IsFiltered("WorldArea::SweepRectThroughTiles") &&
+            runner.IsFiltered("WorldArea::CheckRectangleWalkable") &&
+            runner.IsFiltered("WorldArea::FindNearestClearTile") && runner.IsFiltered("WorldArea::Raycast") &&
+            runner.IsFiltered("WorldArea::RaycastBatch")) {
+            return;
+        }
+
+        auto area = DungeonAreaGen(*fs.GetRootNode()).GenerateNewArea(AreaSize, AreaSize);
+        if (!area) {
+            std::cerr << "ERROR - Bench - Failed to generate area for tile collision benchmarks!\n";
+            return;
+        }
+
+        // move rects about the start room so that most moves touch walls
+        auto startEnt = area->GetEntity<PlayerDefaultStartEntity>(area->GetFirstEntityOfType<PlayerDefaultStartEntity>());
+        auto startPos = startEnt ? startEnt->GetPosition() :
+            0.5f * sf::Vector2f(AreaSize * BaseTile::TileSize.x, AreaSize * BaseTile::TileSize.y);
+
+        std::vector<sf::FloatRect> moveRects;
+        std::vector<sf::Vector2f> moveDisplacements;
+
+        for (int i = 0; i < 1024; ++i) {
+            moveRects.emplace_back(
+                startPos.x + Helper::GenerateRandomReal(rng, -64.0f, 64.0f),
+                startPos.y + Helper::GenerateRandomReal(rng, -64.0f, 64.0f),
+                12.0f, 12.0f);
+            moveDisplacements.emplace_back(
+                Helper::GenerateRandomReal(rng, -48.0f, 48.0f),
+                Helper::GenerateRandomReal(rng, -48.0f, 48.0f));
+        }
+
+        runner.Run("WorldArea::TryCollisionRectMove", 100000, [&](u64 i) {
+            sf::Vector2f endPos;
+            auto idx = i % moveRects.size();
+
+            BenchKeep(area->TryCollisionRectMove(moveRects[idx], moveDisplacements[idx], &endPos));
+        });
+
+        std::vector<FixedRect> fixedMoveRects;
+        std::vector<FixedVector2> fixedMoveDisplacements;
+        for (std::size_t i = 0; i < moveRects.size(); ++i) {
+            fixedMoveRects.emplace_back(FixedRect::FromFloat(moveRects[i]));
+            fixedMoveDisplacements.emplace_back(FixedVector2::FromFloat(moveDisplacements[i]));
+        }
+
+        runner.Run("WorldArea::TryCollisionRectMoveFixed", 100000, [&](u64 i) {
+            FixedVector2 endPos;
+            auto idx = i % fixedMoveRects.size();
+
+            BenchKeep(area->TryCollisionRectMoveFixed(fixedMoveRects[idx], fixedMoveDisplacements[idx], &endPos));
+        });
+
+        runner.Run("WorldArea::SweepRectThroughTiles", 100000, [&](u64 i) {
+            auto idx = i % moveRects.size();
+
+            BenchKeep(static_cast<u64>(1000.0f * area->SweepRectThroughTiles(moveRects[idx], moveDisplacements[idx])));
+        });
+
+        std::vector<sf::Vector2u> walkableTopLefts;
+        for (int i = 0; i < 1024; ++i) {
+            walkableTopLefts.emplace_back(
+                Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 4),
+                Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 4));
+        }
+
+        runner.Run("WorldArea::CheckRectangleWalkable", 1000000, [&](u64 i) {
+            auto& topLeft = walkableTopLefts[i % walkableTopLefts.size()];
+
+            BenchKeep(area->CheckRectangleWalkable(topLeft.x, topLeft.y, 3, 3));
+        });
+
+        runner.Run("WorldArea::FindNearestClearTile", 100000, [&](u64 i) {
+            auto& pos = walkableTopLefts[i % walkableTopLefts.size()];
+            u32 clearX, clearY;
+
+            BenchKeep(area->FindNearestClearTile(pos.x, pos.y, 2, 8, &clearX, &clearY));
+        });
+
+        // aggro-length rays about the start room, so some see out & some hit walls
+        std::vector<WorldArea::RaycastQuery> rayQueries;
+        for (int i = 0; i < 1024; ++i) {
+            auto from = startPos + sf::Vector2f(Helper::GenerateRandomReal(rng, -64.0f, 64.0f),
+                Helper::GenerateRandomReal(rng, -64.0f, 64.0f));
+            auto to = from + sf::Vector2f(Helper::GenerateRandomReal(rng, -128.0f, 128.0f),
+                Helper::GenerateRandomReal(rng, -128.0f, 128.0f));
+
+            rayQueries.push_back(WorldArea::RaycastQuery{from, to});
+        }
+
+        runner.Run("WorldArea::Raycast", 100000, [&](u64 i) {
+            auto& query = rayQueries[i % rayQueries.size()];
+            WorldArea::RaycastHit hit;
+
+            BenchKeep(area->Raycast(query.from, query.to, &hit));
+        });
+
+        std::vector<WorldArea::RaycastHit> rayHits(rayQueries.size());
+
+        runner.Run("WorldArea::RaycastBatch", 100, [&](u64) {
+            area->RaycastBatch(rayQueries.data(), rayQueries.size(), rayHits.data());
+            BenchKeep(rayHits[0].hit);
+        });
+    }
+
+
+    void BenchEntityQueries(BenchRunner& runner, Rng& rng, std::size_t entCount)
+    {
+        auto suffix = "/ents=" + std::to_string(entCount);
+
+        WorldArea area(nullptr, AreaSize, AreaSize);
+
+        // half of the ents are units so the filtered queries have to reject some
+        for (std::size_t i = 0; i < entCount; ++i) {
+            WorldEntity* ent;
+
+            if (i % 2 == 0) {
+                ent = area.GetEntity<WorldEntity>(area.EmplaceEntity<BenchPropEntity>());
+            }
+            else {
+                ent = area.GetEntity<WorldEntity>(area.EmplaceEntity<BenchUnitEntity>());
+            }
+
+            ent->SetSize(sf::Vector2f(16.0f, 16.0f));
+            ent->SetPosition(GenerateRandomAreaPosition(rng));
+        }
+
+        std::vector<sf::Vector2f> queryPositions;
+        for (int i = 0; i < 256; ++i) {
+            queryPositions.emplace_back(GenerateRandomAreaPosition(rng));
+        }
+
+        const float queryRange = 64.0f;
+        const u64 iterations = std::max<u64>(10, 1000000 / std::max<std::size_t>(1, entCount));
+
+        auto getQueryRect = [&](u64 i) {
+            auto& pos = queryPositions[i % queryPositions.size()];
+            return sf::FloatRect(pos.x - queryRange, pos.y - queryRange, queryRange * 2.0f, queryRange * 2.0f);
+        };
+
+        runner.Run("WorldArea::GetWorldEntitiesInRange<WorldEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetWorldEntitiesInRange(queryPositions[i % queryPositions.size()], queryRange).size());
+        });
+
+        runner.Run("WorldArea::GetWorldEntitiesInRange<UnitEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetWorldEntitiesInRange<UnitEntity>(
+                queryPositions[i % queryPositions.size()], queryRange).size());
+        });
+
+        runner.Run("WorldArea::ForEachInRange<UnitEntity>" + suffix, iterations, [&](u64 i) {
+            u64 count = 0;
+            area.ForEachInRange<UnitEntity>(queryPositions[i % queryPositions.size()], queryRange,
+                [&count](UnitEntity*, float) { ++count; });
+            BenchKeep(count);
+        });
+
+        runner.Run("WorldArea::GetAllWorldEntsInRectangle<WorldEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetAllWorldEntsInRectangle(getQueryRect(i)).size());
+        });
+
+        runner.Run("WorldArea::GetAllWorldEntsInRectangle<UnitEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetAllWorldEntsInRectangle<UnitEntity>(getQueryRect(i)).size());
+        });
+
+        runner.Run("WorldArea::ForEachInRect<UnitEntity>" + suffix, iterations, [&](u64 i) {
+            u64 count = 0;
+            area.ForEachInRect<UnitEntity>(getQueryRect(i), [&count](UnitEntity*) { ++count; });
+            BenchKeep(count);
+        });
+
+        runner.Run("WorldArea::GetFirstWorldEntInRectangle<WorldEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetFirstWorldEntInRectangle(getQueryRect(i)));
+        });
+
+        runner.Run("WorldArea::GetFirstWorldEntInRectangle<UnitEntity>" + suffix, iterations, [&](u64 i) {
+            BenchKeep(area.GetFirstWorldEntInRectangle<UnitEntity>(getQueryRect(i)));
+        });
+    }
+
+
+    /**
+    * Checks Collision::RectangleAABBSweepBatch() against a loop of scalar RectangleAABBSweep()s over random
+    * batches, returning false (after saying where) on the first result that differs in any bit. Values are
+    * often picked from a small set, so that NaNs, signed zeros, infinities & exactly tied times come up.
+    */
+    bool CheckAABBSweepBatchParity(Rng& rng)
+    {
+        const float specialValues[] = {
+            0.0f, -0.0f, 1.0f, -1.0f, 8.0f, 16.0f,
+            std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity()
+        };
+        const auto specialCount = sizeof(specialValues) / sizeof(specialValues[0]);
+
+        auto generateValue = [&](float min, float max) {
+            if (Helper::GenerateRandomInt(rng, 0, 3) == 0) {
+                return specialValues[Helper::GenerateRandomInt<Rng, std::size_t>(rng, 0, specialCount - 1)];
+            }
+
+            // whole numbers tie a lot more often than arbitrary reals do
+            auto value = Helper::GenerateRandomReal(rng, min, max);
+            return Helper::GenerateRandomInt(rng, 0, 1) == 0 ? std::floor(value) : value;
+        };
+
+        auto generateRect = [&]() {
+            return CollisionRectInfo(sf::FloatRect(generateValue(0.0f, 64.0f), generateValue(0.0f, 64.0f),
+                generateValue(0.0f, 16.0f), generateValue(0.0f, 16.0f)),
+                sf::Vector2f(generateValue(-32.0f, 32.0f), generateValue(-32.0f, 32.0f)));
+        };
+
+        auto sameBits = [](float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; };
+
+        std::vector<CollisionRectInfo> rects;
+        CollisionRectBatch batch;
+
+        for (int trial = 0; trial < 100000; ++trial) {
+            auto mover = generateRect();
+            auto count = Helper::GenerateRandomInt<Rng, std::size_t>(rng, 0, 40);
+
+            rects.clear();
+            batch.Clear();
+
+            for (std::size_t i = 0; i < count; ++i) {
+                // repeat earlier rects now & then, so the lowest index has to win the tie
+                rects.push_back(i > 0 && Helper::GenerateRandomInt(rng, 0, 3) == 0 ?
+                    rects[Helper::GenerateRandomInt<Rng, std::size_t>(rng, 0, i - 1)] : generateRect());
+                batch.Add(rects.back());
+            }
+
+            float expectedTime = 1.0f;
+            std::size_t expectedIndex = count;
+            sf::Vector2f expectedNormal;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                auto relativeMover = mover;
+                relativeMover.velocity = mover.velocity - rects[i].velocity;
+
+                sf::Vector2f normal;
+                auto time = Collision::RectangleAABBSweep(relativeMover, rects[i], &normal);
+
+                if (time < expectedTime) {
+                    expectedTime = time;
+                    expectedIndex = i;
+                    expectedNormal = normal;
+                }
+            }
+
+            sf::Vector2f normal;
+            std::size_t index;
+            auto time = Collision::RectangleAABBSweepBatch(mover, batch, &normal, &index);
+
+            if (!sameBits(time, expectedTime) || index != expectedIndex ||
+                !sameBits(normal.x, expectedNormal.x) || !sameBits(normal.y, expectedNormal.y)) {
+                std::cerr << "ERROR - Bench - RectangleAABBSweepBatch() differs from RectangleAABBSweep() in trial "
+                    << trial << " (" << count << " rect(s)): time " << time << " vs " << expectedTime << ", index "
+                    << index << " vs " << expectedIndex << ", normal (" << normal.x << ", " << normal.y << ") vs ("
+                    << expectedNormal.x << ", " << expectedNormal.y << ")\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    void BenchAABBSweep(BenchRunner& runner, Rng& rng)
+    {
+        std::vector<std::pair<CollisionRectInfo, CollisionRectInfo>> sweepPairs;
+
+        for (int i = 0; i < 1024; ++i) {
+            sweepPairs.emplace_back(
+                CollisionRectInfo(sf::FloatRect(
+                    Helper::GenerateRandomReal(rng, 0.0f, 64.0f), Helper::GenerateRandomReal(rng, 0.0f, 64.0f), 8.0f, 8.0f),
+                    sf::Vector2f(Helper::GenerateRandomReal(rng, -32.0f, 32.0f), Helper::GenerateRandomReal(rng, -32.0f, 32.0f))),
+                CollisionRectInfo(sf::FloatRect(
+                    Helper::GenerateRandomReal(rng, 0.0f, 64.0f), Helper::GenerateRandomReal(rng, 0.0f, 64.0f), 16.0f, 16.0f)));
+        }
+
+        runner.Run("Collision::RectangleAABBSweep", 1000000, [&](u64 i) {
+            auto& sweepPair = sweepPairs[i % sweepPairs.size()];
+            sf::Vector2f normal;
+
+            BenchKeep(static_cast<u64>(1000.0f * Collision::RectangleAABBSweep(sweepPair.first, sweepPair.second, &normal)));
+        });
+
+        // one mover against a packed set of static rects, scalar vs batched
+        CollisionRectBatch batch;
+        for (auto& sweepPair : sweepPairs) {
+            batch.Add(sweepPair.second);
+        }
+
+        runner.Run("Collision::RectangleAABBSweep/loop/rects=1024", 1000, [&](u64 i) {
+            auto& mover = sweepPairs[i % sweepPairs.size()].first;
+            float earliest = 1.0f;
+
+            for (auto& sweepPair : sweepPairs) {
+                earliest = std::min(earliest, Collision::RectangleAABBSweep(mover, sweepPair.second, nullptr));
+            }
+
+            BenchKeep(static_cast<u64>(1000.0f * earliest));
+        });
+
+        runner.Run("Collision::RectangleAABBSweepBatch/rects=1024", 1000, [&](u64 i) {
+            auto& mover = sweepPairs[i % sweepPairs.size()].first;
+            sf::Vector2f normal;
+
+            BenchKeep(static_cast<u64>(1000.0f * Collision::RectangleAABBSweepBatch(mover, batch, &normal)));
+        });
+    }
+
+
+    void BenchAliveStats(BenchRunner& runner, Rng& rng)
+    {
+        AliveStatsStore store;
+        std::vector<std::unique_ptr<AliveStats>> stats;
+        std::vector<AliveStatsStore::Slot> aoeSlots;
+
+        for (int i = 0; i < 10000; ++i) {
+            stats.emplace_back(std::make_unique<AliveStats>(store));
+            stats.back()->SetMaxHealth(1000);
+            stats.back()->SetHealth(Helper::GenerateRandomInt<Rng, u32>(rng, 0, 1000));
+            stats.back()->SetMaxMana(1000);
+
+            if (i % 8 == 0) {
+                aoeSlots.emplace_back(stats.back()->GetSlot());
+            }
+        }
+
+        runner.Run("AliveStatsStore::CountAlive/slots=10000", 1000, [&](u64) {
+            BenchKeep(store.CountAlive());
+        });
+
+        runner.Run("AliveStatsStore::ApplyRegen/slots=10000", 1000, [&](u64) {
+            store.ApplyRegen(1, 1);
+        });
+
+        runner.Run("AliveStatsStore::ApplyDamage/slots=1250", 1000, [&](u64) {
+            BenchKeep(store.ApplyDamage(aoeSlots.data(), aoeSlots.size(), 1));
+        });
+    }
+
+
+    void BenchFilesystemPaths(BenchRunner& runner, GameFilesystem& fs)
+    {
+        std::vector<GameFilesystemNode*> nodes;
+        CollectNodes(*fs.GetRootNode(), nodes);
+
+        std::vector<std::string> paths;
+        for (auto node : nodes) {
+            paths.emplace_back(GameFilesystem::GetNodePathString(*node));
+        }
+
+        runner.Run("GameFilesystem::GetNodePathString", 100000, [&](u64 i) {
+            BenchKeep(GameFilesystem::GetNodePathString(*nodes[i % nodes.size()]).size());
+        });
+
+        runner.Run("GameFilesystem::GetNodeFromPathString", 100000, [&](u64 i) {
+            BenchKeep(reinterpret_cast<std::uintptr_t>(fs.GetNodeFromPathString(paths[i % paths.size()])));
+        });
+    }
+
+
+    void BenchAreaGen(BenchRunner& runner, GameFilesystem& fs)
+    {
+        std::vector<GameFilesystemNode*> nodes;
+        CollectNodes(*fs.GetRootNode(), nodes);
+
+        std::vector<GameFilesystemNode*> dirNodes;
+        std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(dirNodes),
+            [](const GameFilesystemNode* node) { return node->IsDirectory(); });
+
+        std::sort(dirNodes.begin(), dirNodes.end(), [](const GameFilesystemNode* a, const GameFilesystemNode* b) {
+            return a->GetChildrenCount() < b->GetChildrenCount();
+        });
+
+        if (dirNodes.empty()) {
+            return;
+        }
+
+        // smallest, median & largest directories
+        std::vector<GameFilesystemNode*> genNodes = {
+            dirNodes.front(), dirNodes[dirNodes.size() / 2], dirNodes.back()
+        };
+        genNodes.erase(std::unique(genNodes.begin(), genNodes.end()), genNodes.end());
+
+        for (auto node : genNodes) {
+            runner.Run("DungeonAreaGen::GenerateNewArea/children=" + std::to_string(node->GetChildrenCount()), 5,
+                [&](u64) {
+                    BenchKeep(reinterpret_cast<std::uintptr_t>(DungeonAreaGen(*node).GenerateNewArea(AreaSize, AreaSize).get()));
+                });
+        }
+    }
+
+
+    void BenchNavGraph(BenchRunner& runner, Rng& rng, GameFilesystem& fs)
+    {
+        if (runner.IsFiltered("WorldArea::FindPath")) {
+            return;
+        }
+
+        // the biggest directory makes the most rooms
+        std::vector<GameFilesystemNode*> nodes;
+        CollectNodes(*fs.GetRootNode(), nodes);
+
+        GameFilesystemNode* genNode = nullptr;
+        for (auto node : nodes) {
+            if (node->IsDirectory() && (!genNode || node->GetChildrenCount() > genNode->GetChildrenCount())) {
+                genNode = node;
+            }
+        }
+
+        auto area = DungeonAreaGen(*genNode).GenerateNewArea(AreaSize, AreaSize);
+        if (!area) {
+            std::cerr << "ERROR - Bench - Failed to generate area for nav graph benchmarks!\n";
+            return;
+        }
+
+        // paths between random walkable spots across the whole floor
+        std::vector<std::pair<sf::Vector2f, sf::Vector2f>> pathEnds;
+        for (u32 tryCount = 0; pathEnds.size() < 256; ++tryCount) {
+            if (tryCount >= 10000) {
+                std::cerr << "ERROR - Bench - Failed to find enough walkable tiles for nav graph benchmarks!\n";
+                return;
+            }
+
+            u32 fromX, fromY, toX, toY;
+
+            if (area->FindNearestClearTile(Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 1),
+                Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 1), 1, AreaSize, &fromX, &fromY) &&
+                area->FindNearestClearTile(Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 1),
+                Helper::GenerateRandomInt<Rng, u32>(rng, 0, AreaSize - 1), 1, AreaSize, &toX, &toY)) {
+                pathEnds.emplace_back(
+                    sf::Vector2f((fromX + 0.5f) * BaseTile::TileSize.x, (fromY + 0.5f) * BaseTile::TileSize.y),
+                    sf::Vector2f((toX + 0.5f) * BaseTile::TileSize.x, (toY + 0.5f) * BaseTile::TileSize.y));
+            }
+        }
+
+        std::vector<sf::Vector2f> waypoints;
+
+        runner.Run("WorldArea::FindPath", 10000, [&](u64 i) {
+            auto& ends = pathEnds[i % pathEnds.size()];
+
+            BenchKeep(area->FindPath(ends.first, ends.second, &waypoints) ? waypoints.size() : 0);
+        });
+    }
+
+
+    void BenchFilesystemGen(BenchRunner& runner, RngInt seed)
+    {
+        runner.Run("GameFilesystemGen::GenerateNewFilesystem", 5, [&](u64 i) {
+            BenchKeep(reinterpret_cast<std::uintptr_t>(
+                GameFilesystemGen(static_cast<RngInt>(seed + i)).GenerateNewFilesystem().get()));
+        });
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string outPath = "bench.json";
+    std::string filter;
+    u32 samples = 5;
+    RngInt seed = 1234;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<RngInt>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--out file.json] [--filter name] [--samples n] [--seed n]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    BenchRunner runner(filter, samples);
+    Rng rng(seed);
+
+    auto fs = GameFilesystemGen(seed).GenerateNewFilesystem();
+    if (!fs || !fs->GetRootNode()) {
+        std::cerr << "ERROR - Bench - Failed to generate filesystem! Exiting\n";
+        return EXIT_FAILURE;
+    }
+
+    BenchTileCollision(runner, rng, *fs);
+
+    for (std::size_t entCount : { 10, 100, 1000, 10000 }) {
+        BenchEntityQueries(runner, rng, entCount);
+    }
+
+    // don't time the batched sweep if it isn't giving the same answers
+    if (!CheckAABBSweepBatchParity(rng)) {
+        return EXIT_FAILURE;
+    }
+
+    BenchAABBSweep(runner, rng);
+    BenchAliveStats(runner, rng);
+    BenchFilesystemPaths(runner, *fs);
+    BenchAreaGen(runner, *fs);
+    BenchNavGraph(runner, rng, *fs);
+    BenchFilesystemGen(runner, seed);
+
+    std::ofstream outFile(outPath);
+    if (!outFile) {
+        std::cerr << "ERROR - Bench - Failed to open '" << outPath << "' for writing! Exiting\n";
+        return EXIT_FAILURE;
+    }
+
+    runner.WriteJson(outFile, seed);
+    std::cerr << "Wrote " << runner.GetResults().size() << " benchmark result(s) to '" << outPath << "'\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include "BenchRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "Profiler.h"
+
+
+volatile u64 benchSink = 0;
+
+
+BenchRunner::BenchRunner(const std::string& filter, u32 samples) :
+filter_(filter),
+samples_(std::max<u32>(1, samples))
+{
+}
+
+
+BenchRunner::~BenchRunner()
+{
+}
+
+
+void BenchRunner::Run(const std::string& name, u64 iterations, const std::function<void(u64)>& func)
+{
+    if (IsFiltered(name)) {
+        return;
+    }
+
+    iterations = std::max<u64>(1, iterations);
+
+    // warm up caches & lazy init
+    for (u64 i = 0; i < std::min<u64>(iterations, 16); ++i) {
+        func(i);
+    }
+
+    std::vector<double> sampleNsPerOp;
+    u64 totalAllocs = 0;
+
+    for (u32 s = 0; s < samples_; ++s) {
+        Profiler::Get().BeginFrame();
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (u64 i = 0; i < iterations; ++i) {
+            func(i);
+        }
+
+        auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        Profiler::Get().EndFrame();
+
+        sampleNsPerOp.emplace_back(static_cast<double>(elapsedNs) / iterations);
+        totalAllocs += Profiler::Get().GetLastFrameAllocCount();
+    }
+
+    std::sort(sampleNsPerOp.begin(), sampleNsPerOp.end());
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.samples = samples_;
+    result.nsPerOpMin = sampleNsPerOp.front();
+    result.nsPerOpMedian = sampleNsPerOp[sampleNsPerOp.size() / 2];
+
+    result.nsPerOpMean = 0.0;
+    for (auto ns : sampleNsPerOp) {
+        result.nsPerOpMean += ns;
+    }
+    result.nsPerOpMean /= sampleNsPerOp.size();
+
+    result.allocsPerOp = Profiler::IsTrackingAllocations() ?
+        static_cast<double>(totalAllocs) / (static_cast<double>(iterations) * samples_) : -1.0;
+
+    std::cerr << "BENCH " << name << ": " << result.nsPerOpMedian << " ns/op (median of " << samples_
+        << " x " << iterations << ")\n";
+
+    results_.emplace_back(result);
+}
+
+
+void BenchRunner::WriteJson(std::ostream& os, u32 seed) const
+{
+    auto writeString = [&os](const std::string& str) {
+        os << '"';
+        for (auto c : str) {
+            if (c == '"' || c == '\\') {
+                os << '\\';
+            }
+
+            os << c;
+        }
+        os << '"';
+    };
+
+    os << "{\n  \"seed\": " << seed << ",\n  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+        auto& result = results_[i];
+
+        os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeString(result.name);
+        os << ", \"iterations\": " << result.iterations
+            << ", \"samples\": " << result.samples
+            << ", \"ns_per_op_min\": " << result.nsPerOpMin
+            << ", \"ns_per_op_median\": " << result.nsPerOpMedian
+            << ", \"ns_per_op_mean\": " << result.nsPerOpMean;
+
+        if (result.allocsPerOp >= 0.0) {
+            os << ", \"allocs_per_op\": " << result.allocsPerOp;
+        }
+
+        os << "}";
+    }
+
+    os << "\n  ]\n}\n";
+}
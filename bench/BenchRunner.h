@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+
+#include "Types.h"
+
+/**
+* Timing results of a single benchmark.
+*/
+struct BenchResult
+{
+    std::string name;
+
+    u64 iterations;
+    u32 samples;
+
+    double nsPerOpMin;
+    double nsPerOpMedian;
+    double nsPerOpMean;
+
+    /**
+    * Heap allocations per op; negative if allocation tracking isn't compiled in.
+    */
+    double allocsPerOp;
+};
+
+/**
+* Runs benchmarks & collects their results so they can be written as JSON.
+*/
+class BenchRunner
+{
+    std::string filter_;
+    u32 samples_;
+
+    std::vector<BenchResult> results_;
+
+public:
+    BenchRunner(const std::string& filter = std::string(), u32 samples = 5);
+    ~BenchRunner();
+
+    /**
+    * Times func, which performs a single op, over the given number of iterations
+    * for each sample. Skipped if the name doesn't contain the filter string.
+    */
+    void Run(const std::string& name, u64 iterations, const std::function<void(u64)>& func);
+
+    inline bool IsFiltered(const std::string& name) const
+    {
+        return !filter_.empty() && name.find(filter_) == std::string::npos;
+    }
+
+    void WriteJson(std::ostream& os, u32 seed) const;
+
+    inline const std::vector<BenchResult>& GetResults() const { return results_; }
+};
+
+extern volatile u64 benchSink;
+
+/**
+* Folds a result into a volatile sink so the compiler can't optimise the op away.
+*/
+inline void BenchKeep(u64 value)
+{
+    benchSink = benchSink ^ value;
+}
@@ -0,0 +1,111 @@
+#include "AliveStatsStore.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+AliveStatsStore::AliveStatsStore()
+{
+}
+
+
+AliveStatsStore::~AliveStatsStore()
+{
+}
+
+
+AliveStatsStore::Slot AliveStatsStore::Allocate()
+{
+    Slot slot;
+
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else {
+        slot = static_cast<Slot>(health_.size());
+
+        maxHealth_.emplace_back();
+        health_.emplace_back();
+        maxMana_.emplace_back();
+        mana_.emplace_back();
+        meleeAttack_.emplace_back();
+        magicAttack_.emplace_back();
+        meleeDefence_.emplace_back();
+        magicDefence_.emplace_back();
+        moveSpeed_.emplace_back();
+    }
+
+    ResetSlot(slot);
+    return slot;
+}
+
+
+void AliveStatsStore::Release(Slot slot)
+{
+    assert(slot < health_.size());
+
+    // zero health so batch ops treat the slot as dead
+    health_[slot] = 0;
+    mana_[slot] = 0;
+    freeSlots_.emplace_back(slot);
+}
+
+
+void AliveStatsStore::ResetSlot(Slot slot)
+{
+    maxHealth_[slot] = 1;
+    health_[slot] = 1;
+    maxMana_[slot] = 1;
+    mana_[slot] = 1;
+    meleeAttack_[slot] = 0;
+    magicAttack_[slot] = 0;
+    meleeDefence_[slot] = 0;
+    magicDefence_[slot] = 0;
+    moveSpeed_[slot] = 45.0f;
+}
+
+
+std::size_t AliveStatsStore::CountAlive() const
+{
+    std::size_t count = 0;
+
+    for (auto health : health_) {
+        count += health > 0 ? 1 : 0;
+    }
+
+    return count;
+}
+
+
+void AliveStatsStore::ApplyRegen(u32 healthAmount, u32 manaAmount)
+{
+    const auto slotCount = health_.size();
+
+    for (std::size_t i = 0; i < slotCount; ++i) {
+        // dead (and released) slots don't regen
+        auto alive = health_[i] > 0;
+        auto healthGain = alive ? healthAmount : 0u;
+        auto manaGain = alive ? manaAmount : 0u;
+
+        health_[i] = std::min(maxHealth_[i], health_[i] + std::min(healthGain, UINT32_MAX - health_[i]));
+        mana_[i] = std::min(maxMana_[i], mana_[i] + std::min(manaGain, UINT32_MAX - mana_[i]));
+    }
+}
+
+
+std::size_t AliveStatsStore::ApplyDamage(const Slot* slots, std::size_t slotCount, u32 damage)
+{
+    std::size_t killed = 0;
+
+    for (std::size_t i = 0; i < slotCount; ++i) {
+        auto& health = health_[slots[i]];
+
+        if (health > 0) {
+            health -= std::min(damage, health);
+            killed += health == 0 ? 1 : 0;
+        }
+    }
+
+    return killed;
+}
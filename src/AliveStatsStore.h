@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "Types.h"
+
+/**
+* Struct-of-arrays storage for the stats of AliveEntities. Each AliveStats owns a slot
+* in a store; WorldAreas keep one for their ents so batch operations over them are tight
+* loops over contiguous arrays. Released slots have 0 health, so batch ops skip them
+* without needing to check.
+*/
+class AliveStatsStore
+{
+    // AliveStats reads & writes its slot directly
+    friend class AliveStats;
+
+public:
+    typedef u32 Slot;
+
+private:
+    std::vector<u32> maxHealth_, health_;
+    std::vector<u32> maxMana_, mana_;
+    std::vector<u32> meleeAttack_, magicAttack_;
+    std::vector<u32> meleeDefence_, magicDefence_;
+    std::vector<float> moveSpeed_;
+
+    std::vector<Slot> freeSlots_;
+
+    Slot Allocate();
+    void Release(Slot slot);
+
+    void ResetSlot(Slot slot);
+
+public:
+    AliveStatsStore();
+    ~AliveStatsStore();
+
+    /**
+    * Store for stats that don't belong to any area (those of the player & of
+    * ents that haven't been added to an area yet).
+    */
+    static inline AliveStatsStore& GetDetached()
+    {
+        static AliveStatsStore instance;
+        return instance;
+    }
+
+    std::size_t CountAlive() const;
+
+    /**
+    * Heals & restores mana of every alive slot, clamped to their maximums.
+    */
+    void ApplyRegen(u32 healthAmount, u32 manaAmount);
+
+    /**
+    * Applies damage to each of the given slots. Returns the amount of them killed by it.
+    */
+    std::size_t ApplyDamage(const Slot* slots, std::size_t slotCount, u32 damage);
+
+    inline std::size_t GetSlotCount() const { return health_.size(); }
+    inline std::size_t GetUsedSlotCount() const { return health_.size() - freeSlots_.size(); }
+};
@@ -0,0 +1,119 @@
+/**
+* Optional global operator new/delete replacements that report every heap
+* allocation made on the game thread to the Profiler, so allocations can be
+* attributed to the active profiler zone.
+*
+* Only compiled in when UOLEDUGAME_TRACK_ALLOCATIONS is defined (see the
+* CMake option of the same name).
+*/
+#ifdef UOLEDUGAME_TRACK_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+#include "Profiler.h"
+
+
+namespace
+{
+    void* TrackedAlloc(std::size_t size)
+    {
+        if (size == 0) {
+            size = 1;
+        }
+
+        void* ptr;
+        while (!(ptr = std::malloc(size))) {
+            auto handler = std::get_new_handler();
+            if (!handler) {
+                return nullptr;
+            }
+
+            handler();
+        }
+
+        Profiler::Get().RecordAllocation(size);
+        return ptr;
+    }
+
+
+    void TrackedFree(void* ptr)
+    {
+        if (ptr) {
+            Profiler::Get().RecordFree();
+            std::free(ptr);
+        }
+    }
+}
+
+
+void* operator new(std::size_t size)
+{
+    auto ptr = TrackedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void* operator new[](std::size_t size)
+{
+    auto ptr = TrackedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAlloc(size);
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAlloc(size);
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    TrackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+    TrackedFree(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    TrackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    TrackedFree(ptr);
+}
+
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    TrackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    TrackedFree(ptr);
+}
+
+#endif
@@ -29,7 +29,7 @@ void SparkleEntity::Tick()
 }
 
 
-void SparkleEntity::Render(sf::RenderTarget& target)
+void SparkleEntity::Render(CountingRenderTarget& target)
 {
     sf::Sprite sparkleSprite(anim_.GetCurrentFrame());
     sparkleSprite.setPosition(GetPosition());
@@ -108,7 +108,7 @@ void AltarEntity::Tick()
 }
 
 
-void AltarEntity::Render(sf::RenderTarget& target)
+void AltarEntity::Render(CountingRenderTarget& target)
 {
     if (IsRevealed()) {
         sf::Sprite altarSprite;
@@ -155,7 +155,7 @@ void AltarEntity::Use(EntityId playerId)
     }
     else if (director.GetCurrentObjectiveType() == GameObjectiveType::RootArtefactAltar) {
         Game::Get().GetDirector().ReleaseTheBoss(area, GetPosition() - sf::Vector2f(8.0f, 100.0f));
-        GameAssets::Get().magicFireSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().magicFireSoundBuffer, area, GetCenterPosition());
     }
     else if (director.GetCurrentObjectiveType() == GameObjectiveType::BossFight) {
         Game::Get().AddMessage("The staircase has been blocked off by magical flames!");
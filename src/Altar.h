@@ -15,9 +15,9 @@ public:
     virtual ~SparkleEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
-    inline virtual std::string GetName() const override { return "SparkleEntity"; }
+    inline virtual const char* GetName() const override { return "SparkleEntity"; }
 };
 
 /**
@@ -35,7 +35,7 @@ public:
     virtual ~AltarEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     bool IsRevealed() const;
 
@@ -45,6 +45,6 @@ public:
     inline virtual bool IsUsable(EntityId playerId) const override { return IsRevealed(); }
 
     inline virtual std::string GetUnitName() const override { return "Altar"; }
-    inline virtual std::string GetName() const override { return "AltarEntity"; }
+    inline virtual const char* GetName() const override { return "AltarEntity"; }
 };
 
@@ -0,0 +1,155 @@
+#include "AudioQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+const std::size_t AudioQueue::VoiceCount;
+const float AudioQueue::AttenuationDistance = 160.0f;
+
+
+AudioQueue::AudioQueue() :
+listenerArea_(nullptr),
+requestedCount_(0),
+coalescedCount_(0),
+culledCount_(0),
+stolenCount_(0)
+{
+    for (auto& voice : voices_) {
+        voice.priority = SoundPriority::Low;
+    }
+}
+
+
+AudioQueue::~AudioQueue()
+{
+}
+
+
+void AudioQueue::Play(const sf::SoundBuffer& buffer, SoundPriority priority)
+{
+    requests_.push_back(SoundRequest{&buffer, priority, nullptr, sf::Vector2f(), 1.0f});
+}
+
+
+void AudioQueue::PlayAt(const sf::SoundBuffer& buffer, const WorldArea* area, const sf::Vector2f& pos,
+    SoundPriority priority)
+{
+    if (area) {
+        requests_.push_back(SoundRequest{&buffer, priority, area, pos, 1.0f});
+    }
+}
+
+
+float AudioQueue::GetListenerVolume(const SoundRequest& request) const
+{
+    if (!request.area) {
+        return 1.0f;
+    }
+
+    if (request.area != listenerArea_) {
+        return 0.0f;
+    }
+
+    // fade out with the distance from pos to the nearest point of the view
+    auto& pos = request.pos;
+    auto dx = std::max(0.0f, std::max(listenerRect_.left - pos.x, pos.x - (listenerRect_.left + listenerRect_.width)));
+    auto dy = std::max(0.0f, std::max(listenerRect_.top - pos.y, pos.y - (listenerRect_.top + listenerRect_.height)));
+
+    return std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy) / AttenuationDistance);
+}
+
+
+void AudioQueue::SetListener(const WorldArea* area, const sf::FloatRect& viewRect)
+{
+    listenerArea_ = area;
+    listenerRect_ = viewRect;
+}
+
+
+AudioQueue::Voice* AudioQueue::FindVoice(SoundPriority priority)
+{
+    Voice* stealVoice = nullptr;
+    float stealProgress = 0.0f;
+
+    for (auto& voice : voices_) {
+        if (voice.sound.getStatus() == sf::SoundSource::Stopped) {
+            return &voice;
+        }
+
+        if (voice.priority > priority) {
+            continue;
+        }
+
+        // steal from the lowest priority, then from whichever is nearest to finishing anyway
+        auto buffer = voice.sound.getBuffer();
+        auto duration = buffer ? buffer->getDuration().asSeconds() : 0.0f;
+        auto progress = duration > 0.0f ? voice.sound.getPlayingOffset().asSeconds() / duration : 1.0f;
+
+        if (!stealVoice || voice.priority < stealVoice->priority ||
+            (voice.priority == stealVoice->priority && progress > stealProgress)) {
+            stealVoice = &voice;
+            stealProgress = progress;
+        }
+    }
+
+    if (stealVoice) {
+        stealVoice->sound.stop();
+        ++stolenCount_;
+    }
+
+    return stealVoice;
+}
+
+
+void AudioQueue::Flush()
+{
+    requestedCount_ += requests_.size();
+
+    for (auto& request : requests_) {
+        auto volume = GetListenerVolume(request);
+
+        if (volume <= 0.0f) {
+            ++culledCount_;
+            continue;
+        }
+
+        // the same sound twice in a frame would only restart it, so play it once, as loud & as
+        // important as the loudest & most important request for it
+        auto it = std::find_if(coalescedRequests_.begin(), coalescedRequests_.end(),
+            [&request](const SoundRequest& other) { return other.buffer == request.buffer; });
+
+        if (it != coalescedRequests_.end()) {
+            it->priority = std::max(it->priority, request.priority);
+            it->volume = std::max(it->volume, volume);
+            ++coalescedCount_;
+        }
+        else {
+            coalescedRequests_.push_back(request);
+            coalescedRequests_.back().volume = volume;
+        }
+    }
+
+    // most important first, so they get the free voices
+    std::sort(coalescedRequests_.begin(), coalescedRequests_.end(), [](const SoundRequest& a, const SoundRequest& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.volume > b.volume;
+    });
+
+    for (auto& request : coalescedRequests_) {
+        auto voice = FindVoice(request.priority);
+
+        if (!voice) {
+            // every voice is busy with something more important
+            ++culledCount_;
+            continue;
+        }
+
+        voice->priority = request.priority;
+        voice->sound.setBuffer(*request.buffer);
+        voice->sound.setVolume(request.volume * 100.0f);
+        voice->sound.play();
+    }
+
+    requests_.clear();
+    coalescedRequests_.clear();
+}
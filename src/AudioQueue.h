@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "Types.h"
+
+class WorldArea;
+
+/**
+* Sound priorities. Higher priority sounds steal voices from lower ones.
+*/
+enum class SoundPriority
+{
+    Low,
+    Normal,
+    High
+};
+
+/**
+* Queues up the sounds requested during a frame & plays them all at once from a fixed pool of voices.
+* Requests for the same sound within a frame are coalesced into one, & sounds from positions
+* outside the listener's view are attenuated or culled.
+*/
+class AudioQueue
+{
+    struct SoundRequest
+    {
+        const sf::SoundBuffer* buffer;
+        SoundPriority priority;
+
+        // positional requests are resolved against the listener when flushed
+        const WorldArea* area;
+        sf::Vector2f pos;
+        float volume;
+    };
+
+    struct Voice
+    {
+        sf::Sound sound;
+        SoundPriority priority;
+    };
+
+    static const std::size_t VoiceCount = 16;
+
+    // positional sounds fade out over this distance beyond the edge of the view, & are culled past it
+    static const float AttenuationDistance;
+
+    std::array<Voice, VoiceCount> voices_;
+    std::vector<SoundRequest> requests_;
+    std::vector<SoundRequest> coalescedRequests_;
+
+    const WorldArea* listenerArea_;
+    sf::FloatRect listenerRect_;
+
+    u64 requestedCount_;
+    u64 coalescedCount_;
+    u64 culledCount_;
+    u64 stolenCount_;
+
+    float GetListenerVolume(const SoundRequest& request) const;
+    Voice* FindVoice(SoundPriority priority);
+
+public:
+    AudioQueue();
+    ~AudioQueue();
+
+    static inline AudioQueue& Get()
+    {
+        static AudioQueue instance;
+        return instance;
+    }
+
+    /**
+    * Queues a sound that isn't from anywhere in the world (UI, the player .etc)
+    */
+    void Play(const sf::SoundBuffer& buffer, SoundPriority priority = SoundPriority::Normal);
+
+    /**
+    * Queues a sound coming from pos in area. Dropped unless area is the listener's when flushed.
+    */
+    void PlayAt(const sf::SoundBuffer& buffer, const WorldArea* area, const sf::Vector2f& pos,
+        SoundPriority priority = SoundPriority::Normal);
+
+    /**
+    * Sets where positional sounds are heard from; the area & the region of it in view.
+    */
+    void SetListener(const WorldArea* area, const sf::FloatRect& viewRect);
+
+    /**
+    * Plays this frame's queued sounds. Call once per frame, after SetListener().
+    */
+    void Flush();
+
+    inline u64 GetRequestedCount() const { return requestedCount_; }
+    inline u64 GetCoalescedCount() const { return coalescedCount_; }
+    inline u64 GetCulledCount() const { return culledCount_; }
+    inline u64 GetStolenCount() const { return stolenCount_; }
+};
@@ -16,6 +16,9 @@ isOpened_(false),
 chestFsNodeName_(chestFsNodeName)
 {
     SetSize(BaseTile::TileSize);
+
+    // chests only change when opened
+    SetDormant(true);
 }
 
 
@@ -38,7 +41,7 @@ void ChestEntity::Use(EntityId playerId)
                 switch (Game::Get().GetDirector().GetQuestionAnswerResult()) {
                 case GameQuestionAnswerResult::Unanswered:
                 case GameQuestionAnswerResult::Wrong:
-                    GameAssets::Get().selectSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer);
                     Game::Get().SetDisplayedQuestion(Game::Get().GetDirector().GetCurrentQuestion());
                     return;
 
@@ -76,7 +79,7 @@ void ChestEntity::Use(EntityId playerId)
         }
 
         isOpened_ = true;
-        GameAssets::Get().openChestSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().openChestSoundBuffer, GetAssignedArea(), GetCenterPosition());
 
         // roll drop tables
         switch (chestDropTable_) {
@@ -189,7 +192,7 @@ void ChestEntity::Use(EntityId playerId)
 }
 
 
-void ChestEntity::Render(sf::RenderTarget& target)
+void ChestEntity::Render(CountingRenderTarget& target)
 {
     sf::Sprite chestSprite(GameAssets::Get().chestsSpriteSheet);
     chestSprite.setPosition(GetPosition());
@@ -45,7 +45,7 @@ public:
         const std::string& chestFsNodeName = std::string());
     virtual ~ChestEntity();
 
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     virtual void Use(EntityId playerId) override;
 
@@ -76,6 +76,6 @@ public:
 
     inline virtual std::string GetUnitName() const override { return "Chest"; }
 
-    inline virtual std::string GetName() const override { return "ChestEntity"; }
+    inline virtual const char* GetName() const override { return "ChestEntity"; }
 };
 
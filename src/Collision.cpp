@@ -1,5 +1,15 @@
 #include "Collision.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "Types.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 
 sf::FloatRect Collision::GetAABBSweepBroadphaseRegion(const CollisionRectInfo& r)
 {
@@ -96,4 +106,185 @@ float Collision::RectangleAABBSweep(const CollisionRectInfo& r1, const Collision
     }
 
     return entryTime;
-}
\ No newline at end of file
+}
+
+float Collision::RectangleSweepFirstContact(const CollisionRectInfo& r1, const CollisionRectInfo& r2,
+    sf::Vector2f* outNormal)
+{
+    if (outNormal) {
+        *outNormal = sf::Vector2f();
+    }
+
+    if (r1.rect.intersects(r2.rect)) {
+        return 0.0f;
+    }
+
+    sf::Vector2f normal;
+    auto time = RectangleAABBSweep(r1, r2, &normal);
+
+    if (time >= 1.0f) {
+        return 1.0f;
+    }
+
+    // at the time of contact, the rectangles must overlap along the other axis, or they only graze
+    auto movedLeft = r1.rect.left + r1.velocity.x * time;
+    auto movedTop = r1.rect.top + r1.velocity.y * time;
+
+    auto overlap = normal.x != 0.0f ?
+        std::min(movedTop + r1.rect.height, r2.rect.top + r2.rect.height) - std::max(movedTop, r2.rect.top) :
+        std::min(movedLeft + r1.rect.width, r2.rect.left + r2.rect.width) - std::max(movedLeft, r2.rect.left);
+
+    if (overlap <= 0.0f) {
+        return 1.0f;
+    }
+
+    if (outNormal) {
+        *outNormal = normal;
+    }
+
+    return time;
+}
+
+
+#ifdef COLLISION_USE_SSE2
+namespace
+{
+    inline __m128 SelectPs(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+}
+#endif
+
+
+float Collision::RectangleAABBSweepBatch(const CollisionRectInfo& r1, const CollisionRectBatch& rects,
+    sf::Vector2f* outNormal, std::size_t* outIndex)
+{
+    const auto count = rects.GetSize();
+
+    float bestTime = 1.0f;
+    std::size_t bestIndex = count;
+    std::size_t i = 0;
+
+#ifdef COLLISION_USE_SSE2
+    // mirrors RectangleAABBSweep() lane by lane; the branches become selects & the max/min operands are
+    // ordered so that ties & NaNs resolve the same way as std::max/std::min
+    if (count >= 4) {
+        const auto zero = _mm_setzero_ps();
+        const auto one = _mm_set1_ps(1.0f);
+        const auto inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        const auto negInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+        const auto left1 = _mm_set1_ps(r1.rect.left);
+        const auto right1 = _mm_set1_ps(r1.rect.left + r1.rect.width);
+        const auto top1 = _mm_set1_ps(r1.rect.top);
+        const auto bottom1 = _mm_set1_ps(r1.rect.top + r1.rect.height);
+        const auto velX1 = _mm_set1_ps(r1.velocity.x);
+        const auto velY1 = _mm_set1_ps(r1.velocity.y);
+
+        auto laneBestTime = one;
+        auto laneBestIndex = _mm_set1_epi32(-1);
+        auto laneIndex = _mm_set_epi32(3, 2, 1, 0);
+        const auto laneIndexStep = _mm_set1_epi32(4);
+
+        for (; i + 4 <= count; i += 4) {
+            auto left2 = _mm_loadu_ps(&rects.left[i]);
+            auto right2 = _mm_add_ps(left2, _mm_loadu_ps(&rects.width[i]));
+            auto top2 = _mm_loadu_ps(&rects.top[i]);
+            auto bottom2 = _mm_add_ps(top2, _mm_loadu_ps(&rects.height[i]));
+            auto velX = _mm_sub_ps(velX1, _mm_loadu_ps(&rects.velocityX[i]));
+            auto velY = _mm_sub_ps(velY1, _mm_loadu_ps(&rects.velocityY[i]));
+
+            auto movingPosX = _mm_cmpgt_ps(velX, zero);
+            auto movingPosY = _mm_cmpgt_ps(velY, zero);
+            auto entryInvX = SelectPs(movingPosX, _mm_sub_ps(left2, right1), _mm_sub_ps(right2, left1));
+            auto exitInvX = SelectPs(movingPosX, _mm_sub_ps(right2, left1), _mm_sub_ps(left2, right1));
+            auto entryInvY = SelectPs(movingPosY, _mm_sub_ps(top2, bottom1), _mm_sub_ps(bottom2, top1));
+            auto exitInvY = SelectPs(movingPosY, _mm_sub_ps(bottom2, top1), _mm_sub_ps(top2, bottom1));
+
+            // lanes dividing by 0 are replaced with the infinities anyway
+            auto stillX = _mm_cmpeq_ps(velX, zero);
+            auto stillY = _mm_cmpeq_ps(velY, zero);
+            auto entryX = SelectPs(stillX, negInf, _mm_div_ps(entryInvX, velX));
+            auto exitX = SelectPs(stillX, inf, _mm_div_ps(exitInvX, velX));
+            auto entryY = SelectPs(stillY, negInf, _mm_div_ps(entryInvY, velY));
+            auto exitY = SelectPs(stillY, inf, _mm_div_ps(exitInvY, velY));
+
+            auto entryTime = _mm_max_ps(entryY, entryX);
+            auto exitTime = _mm_min_ps(exitY, exitX);
+
+            auto entryBeforeX = _mm_cmplt_ps(entryX, zero);
+            auto entryBeforeY = _mm_cmplt_ps(entryY, zero);
+            auto apartX = _mm_or_ps(_mm_cmplt_ps(right1, left2), _mm_cmpgt_ps(left1, right2));
+            auto apartY = _mm_or_ps(_mm_cmplt_ps(bottom1, top2), _mm_cmpgt_ps(top1, bottom2));
+
+            auto noCollision = _mm_or_ps(
+                _mm_or_ps(_mm_cmpgt_ps(entryTime, exitTime), _mm_and_ps(entryBeforeX, entryBeforeY)),
+                _mm_or_ps(_mm_and_ps(entryBeforeX, apartX), _mm_and_ps(entryBeforeY, apartY)));
+
+            auto time = SelectPs(noCollision, one, entryTime);
+
+            // each lane keeps the earliest of its own rects; a later index only wins if strictly earlier
+            auto better = _mm_cmplt_ps(time, laneBestTime);
+            laneBestTime = SelectPs(better, time, laneBestTime);
+            laneBestIndex = _mm_or_si128(_mm_and_si128(_mm_castps_si128(better), laneIndex),
+                _mm_andnot_si128(_mm_castps_si128(better), laneBestIndex));
+
+            laneIndex = _mm_add_epi32(laneIndex, laneIndexStep);
+        }
+
+        alignas(16) float laneTimes[4];
+        alignas(16) i32 laneIndices[4];
+        _mm_store_ps(laneTimes, laneBestTime);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), laneBestIndex);
+
+        for (int lane = 0; lane < 4; ++lane) {
+            if (laneIndices[lane] < 0) {
+                continue;
+            }
+
+            auto laneIndexValue = static_cast<std::size_t>(laneIndices[lane]);
+
+            if (laneTimes[lane] < bestTime || (laneTimes[lane] == bestTime && laneIndexValue < bestIndex)) {
+                bestTime = laneTimes[lane];
+                bestIndex = laneIndexValue;
+            }
+        }
+    }
+#endif
+
+    // whatever's left (or everything without SSE2)
+    CollisionRectInfo r2, relativeR1 = r1;
+
+    for (; i < count; ++i) {
+        r2.rect = sf::FloatRect(rects.left[i], rects.top[i], rects.width[i], rects.height[i]);
+        relativeR1.velocity = r1.velocity - sf::Vector2f(rects.velocityX[i], rects.velocityY[i]);
+
+        auto time = RectangleAABBSweep(relativeR1, r2, nullptr);
+
+        if (time < bestTime) {
+            bestTime = time;
+            bestIndex = i;
+        }
+    }
+
+    if (outIndex) {
+        *outIndex = bestIndex;
+    }
+
+    if (outNormal) {
+        if (bestIndex < count) {
+            // only the winner needs its normal, so just redo it with the scalar sweep
+            r2.rect = sf::FloatRect(rects.left[bestIndex], rects.top[bestIndex], rects.width[bestIndex],
+                rects.height[bestIndex]);
+            relativeR1.velocity = r1.velocity - sf::Vector2f(rects.velocityX[bestIndex], rects.velocityY[bestIndex]);
+
+            RectangleAABBSweep(relativeR1, r2, outNormal);
+        }
+        else {
+            *outNormal = sf::Vector2f();
+        }
+    }
+
+    return bestTime;
+}
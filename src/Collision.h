@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #include <SFML/Graphics/Rect.hpp>
 
 /**
@@ -18,6 +21,37 @@ struct CollisionRectInfo
     { }
 };
 
+/**
+* Many collidable rectangles packed as a structure of arrays, so they can be swept against in bulk.
+*/
+struct CollisionRectBatch
+{
+    std::vector<float> left, top, width, height;
+    std::vector<float> velocityX, velocityY;
+
+    inline std::size_t GetSize() const { return left.size(); }
+
+    inline void Clear()
+    {
+        left.clear();
+        top.clear();
+        width.clear();
+        height.clear();
+        velocityX.clear();
+        velocityY.clear();
+    }
+
+    inline void Add(const CollisionRectInfo& r)
+    {
+        left.push_back(r.rect.left);
+        top.push_back(r.rect.top);
+        width.push_back(r.rect.width);
+        height.push_back(r.rect.height);
+        velocityX.push_back(r.velocity.x);
+        velocityY.push_back(r.velocity.y);
+    }
+};
+
 /**
 * Class containing collision handling functions
 */
@@ -44,5 +78,27 @@ public:
     * Credit to: http://www.gamedev.net/page/resources/_/technical/game-programming/swept-aabb-collision-detection-and-response-r3084
     */
     static float RectangleAABBSweep(const CollisionRectInfo& r1, const CollisionRectInfo& r2, sf::Vector2f* outNormal);
+
+    /**
+    * Like RectangleAABBSweep(), but for finding what a moving rectangle r1 runs into: rectangles already
+    * overlapping are hit at 0.0f, & only collisions where the insides of the rectangles meet before the end
+    * of the sweep count (not just their edges, as when sliding along each other).
+    * Returns 1.0f, zeroing outNormal, if there's no such collision.
+    */
+    static float RectangleSweepFirstContact(const CollisionRectInfo& r1, const CollisionRectInfo& r2,
+        sf::Vector2f* outNormal);
+
+    /**
+    * Does an AABB sweep of r1 against every rectangle in rects, moving with r1's velocity relative to each.
+    * Returns the earliest collision time, writing the normal of that collision to outNormal and the index of
+    * the rectangle collided with to outIndex. If none collide before the end of the sweep, 1.0f is returned,
+    * outNormal is zeroed & outIndex is set to rects.GetSize().
+    *
+    * Gives the same results as calling RectangleAABBSweep() for each rectangle with the relative velocity
+    * (r1's alone for static rectangles), & keeping the earliest time (the lowest index of those tied).
+    * Four rectangles are swept at a time where SSE2 is available.
+    */
+    static float RectangleAABBSweepBatch(const CollisionRectInfo& r1, const CollisionRectBatch& rects,
+        sf::Vector2f* outNormal, std::size_t* outIndex = nullptr);
 };
 
@@ -0,0 +1,128 @@
+#include "CountingRenderTarget.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+
+const std::size_t RenderFrameStats::PassCount;
+
+
+std::string RenderFrameStats::GetPassName(RenderPass pass)
+{
+    switch (pass) {
+    case RenderPass::Tiles:
+        return "Tiles";
+
+    case RenderPass::Entities:
+        return "Entities";
+
+    case RenderPass::FrameUI:
+        return "FrameUI";
+
+    case RenderPass::HUD:
+        return "HUD";
+
+    case RenderPass::Debug:
+        return "Debug";
+
+    default:
+        return "Other";
+    }
+}
+
+
+CountingRenderTarget::CountingRenderTarget(sf::RenderTarget& target) :
+target_(target),
+pass_(RenderPass::Other),
+lastTexture_(nullptr)
+{
+}
+
+
+CountingRenderTarget::~CountingRenderTarget()
+{
+}
+
+
+void CountingRenderTarget::CountDraw(const sf::Texture* texture, u64 vertexCount, u64 drawCount)
+{
+    auto& passStats = stats_.GetPass(pass_);
+
+    passStats.draws += drawCount;
+    passStats.vertices += vertexCount;
+
+    if (texture != lastTexture_) {
+        ++passStats.textureSwitches;
+        lastTexture_ = texture;
+    }
+}
+
+
+void CountingRenderTarget::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    CountDraw(states.texture, 0);
+    target_.draw(drawable, states);
+}
+
+
+void CountingRenderTarget::draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+    CountDraw(sprite.getTexture(), 4);
+    target_.draw(sprite, states);
+}
+
+
+void CountingRenderTarget::draw(const sf::Shape& shape, const sf::RenderStates& states)
+{
+    // shapes & text are drawn as 2 batches if they have an outline.
+    u64 pointCount = shape.getPointCount();
+    bool hasOutline = shape.getOutlineThickness() != 0.0f;
+
+    CountDraw(shape.getTexture(), (pointCount + 2) + (hasOutline ? (pointCount + 1) * 2 : 0), hasOutline ? 2 : 1);
+    target_.draw(shape, states);
+}
+
+
+void CountingRenderTarget::draw(const sf::Text& text, const sf::RenderStates& states)
+{
+    u64 glyphCount = 0;
+    const auto& str = text.getString();
+
+    for (std::size_t i = 0; i < str.getSize(); ++i) {
+        if (str[i] != ' ' && str[i] != '\t' && str[i] != '\n') {
+            ++glyphCount;
+        }
+    }
+
+    bool hasOutline = text.getOutlineThickness() != 0.0f;
+    const sf::Texture* fontTexture = text.getFont() ?
+        &text.getFont()->getTexture(text.getCharacterSize()) : nullptr;
+
+    CountDraw(fontTexture, glyphCount * 6 * (hasOutline ? 2 : 1), hasOutline ? 2 : 1);
+    target_.draw(text, states);
+}
+
+
+void CountingRenderTarget::draw(const sf::VertexArray& vertexArray, const sf::RenderStates& states)
+{
+    CountDraw(states.texture, vertexArray.getVertexCount());
+    target_.draw(vertexArray, states);
+}
+
+
+void CountingRenderTarget::draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+    const sf::RenderStates& states)
+{
+    CountDraw(states.texture, vertexCount);
+    target_.draw(vertices, vertexCount, type, states);
+}
+
+
+void CountingRenderTarget::setView(const sf::View& view)
+{
+    ++stats_.GetPass(pass_).viewChanges;
+    target_.setView(view);
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include "Types.h"
+
+namespace sf
+{
+    class Sprite;
+    class Shape;
+    class Text;
+    class VertexArray;
+}
+
+/**
+* The named passes a frame's draws are attributed to.
+*/
+enum class RenderPass
+{
+    Tiles,
+    Entities,
+    FrameUI,
+    HUD,
+    Debug,
+    Other
+};
+
+/**
+* Counters for the draws submitted during a single render pass.
+*/
+struct RenderPassStats
+{
+    u64 draws;
+    u64 vertices;
+    u64 textureSwitches;
+    u64 viewChanges;
+
+    RenderPassStats() :
+        draws(0),
+        vertices(0),
+        textureSwitches(0),
+        viewChanges(0)
+    { }
+
+    inline RenderPassStats& operator+=(const RenderPassStats& other)
+    {
+        draws += other.draws;
+        vertices += other.vertices;
+        textureSwitches += other.textureSwitches;
+        viewChanges += other.viewChanges;
+        return *this;
+    }
+};
+
+/**
+* Draw counters for a whole frame, split by render pass.
+*/
+struct RenderFrameStats
+{
+    static const std::size_t PassCount = static_cast<std::size_t>(RenderPass::Other) + 1;
+
+    std::array<RenderPassStats, PassCount> passes;
+
+    inline RenderPassStats& GetPass(RenderPass pass) { return passes[static_cast<std::size_t>(pass)]; }
+    inline const RenderPassStats& GetPass(RenderPass pass) const { return passes[static_cast<std::size_t>(pass)]; }
+
+    inline RenderPassStats GetTotal() const
+    {
+        RenderPassStats total;
+        for (auto& pass : passes) {
+            total += pass;
+        }
+
+        return total;
+    }
+
+    inline RenderFrameStats& operator+=(const RenderFrameStats& other)
+    {
+        for (std::size_t i = 0; i < PassCount; ++i) {
+            passes[i] += other.passes[i];
+        }
+
+        return *this;
+    }
+
+    static std::string GetPassName(RenderPass pass);
+};
+
+/**
+* Adapter around an sf::RenderTarget that counts the draws, vertices, texture
+* switches and view changes submitted through it for the current pass.
+* Mirrors the subset of the sf::RenderTarget interface that the game uses so
+* the render path can take this in place of the real target.
+* What a drawable submits is worked out from its type at the call site, so
+* drawables only known as an sf::Drawable count as a draw with no vertices.
+*/
+class CountingRenderTarget
+{
+    sf::RenderTarget& target_;
+
+    RenderPass pass_;
+    RenderFrameStats stats_;
+
+    const sf::Texture* lastTexture_;
+
+    void CountDraw(const sf::Texture* texture, u64 vertexCount, u64 drawCount = 1);
+
+public:
+    explicit CountingRenderTarget(sf::RenderTarget& target);
+    ~CountingRenderTarget();
+
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::VertexArray& vertexArray, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+
+    inline void clear(const sf::Color& color = sf::Color(0, 0, 0, 255)) { target_.clear(color); }
+
+    void setView(const sf::View& view);
+    inline const sf::View& getView() const { return target_.getView(); }
+    inline const sf::View& getDefaultView() const { return target_.getDefaultView(); }
+
+    inline sf::Vector2u getSize() const { return target_.getSize(); }
+
+    inline void SetPass(RenderPass pass) { pass_ = pass; }
+    inline RenderPass GetPass() const { return pass_; }
+
+    inline void ResetStats()
+    {
+        stats_ = RenderFrameStats();
+        lastTexture_ = nullptr;
+    }
+
+    inline const RenderFrameStats& GetStats() const { return stats_; }
+
+    inline sf::RenderTarget& GetTarget() { return target_; }
+    inline const sf::RenderTarget& GetTarget() const { return target_; }
+};
+
+/**
+* Sets the pass of a CountingRenderTarget for the lifetime of this object,
+* restoring the previous pass afterwards.
+*/
+class RenderPassScope
+{
+    CountingRenderTarget& target_;
+    RenderPass previousPass_;
+
+public:
+    RenderPassScope(CountingRenderTarget& target, RenderPass pass) :
+    target_(target),
+    previousPass_(target.GetPass())
+    {
+        target_.SetPass(pass);
+    }
+
+    ~RenderPassScope()
+    {
+        target_.SetPass(previousPass_);
+    }
+};
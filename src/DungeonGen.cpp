@@ -5,6 +5,8 @@
 #include <iostream>
 
 #include "Helper.h"
+#include "Log.h"
+#include "Profiler.h"
 #include "World.h"
 #include "Player.h"
 #include "Stairs.h"
@@ -47,7 +49,7 @@ bool DungeonAreaGen::AddPlayerStart(WorldArea& area)
         if (!area.CheckEntRectangleWalkable(sf::FloatRect(
             areaCenter.x - altarEnt->GetSize().x * 0.5f, areaCenter.y - altarEnt->GetSize().y * 0.5f,
             altarEnt->GetSize().x, altarEnt->GetSize().y))) {
-            std::cout << "ERR - DungeonAreaGen - No room to place AltarEntity at player start!\n";
+            LOG_ERROR("DungeonAreaGen - No room to place AltarEntity at player start!");
 
             area.RemoveEntity(altarEnt->GetAssignedId());
             return false;
@@ -65,7 +67,7 @@ bool DungeonAreaGen::AddPlayerStart(WorldArea& area)
         if (!area.CheckEntRectangleWalkable(sf::FloatRect(
             areaCenter.x - upstairEnt->GetSize().x * 0.5f, areaCenter.y - upstairEnt->GetSize().x * 0.5f,
             upstairEnt->GetSize().x, upstairEnt->GetSize().y))) {
-            std::cerr << "ERR - DungeonAreaGen - No room to place UpStairEntity for player start!\n";
+            LOG_ERROR("DungeonAreaGen - No room to place UpStairEntity for player start!");
 
             area.RemoveEntity(upstairEnt->GetAssignedId());
             return false;
@@ -148,6 +150,8 @@ bool DungeonAreaGen::PlaceEmptyRoom(WorldArea& area, Rng& rng, u32 topX, u32 top
         }
     }
 
+    auto region = genRegionCount_++;
+
     for (u32 y = topY; y < (topY + h) && y < area.GetHeight(); ++y) {
         for (u32 x = topX; x < (topX + w) && x < area.GetWidth(); ++x) {
             if (x == topX || x == (topX + w - 1) || y == topY || y == (topY + h - 1)) {
@@ -155,6 +159,7 @@ bool DungeonAreaGen::PlaceEmptyRoom(WorldArea& area, Rng& rng, u32 topX, u32 top
             }
             else {
                 area.SetTile(x, y, floorType);
+                SetGenRegion(area, x, y, region);
 
                 // place sparkles in gold room
                 if (goldRoom) {
@@ -333,6 +338,7 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
     }
 
     u32 growLength = Helper::GenerateRandomInt<Rng, u32>(rng, passageGrowLengthMin_, passageGrowLengthMax_);
+    auto region = genRegionCount_++;
 
     if (growLength > 0) {
         switch (passage.nextDirection) {
@@ -352,6 +358,7 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
                 }
                 else {
                     area.SetTile(passage.posX, passage.posY - i, GenericTileType::PassageFloor);
+                    SetGenRegion(area, passage.posX, passage.posY - i, region);
                 }
             }
 
@@ -374,6 +381,7 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
                 }
                 else {
                     area.SetTile(passage.posX, passage.posY + i, GenericTileType::PassageFloor);
+                    SetGenRegion(area, passage.posX, passage.posY + i, region);
                 }
             }
 
@@ -396,6 +404,7 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
                 }
                 else {
                     area.SetTile(passage.posX - i, passage.posY, GenericTileType::PassageFloor);
+                    SetGenRegion(area, passage.posX - i, passage.posY, region);
                 }
             }
 
@@ -418,6 +427,7 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
                 }
                 else {
                     area.SetTile(passage.posX + i, passage.posY, GenericTileType::PassageFloor);
+                    SetGenRegion(area, passage.posX + i, passage.posY, region);
                 }
             }
 
@@ -493,34 +503,35 @@ bool DungeonAreaGen::GrowActivePassage(WorldArea& area, Rng& rng, ActiveGenPassa
 }
 
 
+bool DungeonAreaGen::IsSpawnTileFree(const WorldArea& area, u32 x, u32 y) const
+{
+    return area.GetFirstWorldEntInRectangle<UnitEntity>(sf::FloatRect(
+        x * BaseTile::TileSize.x, y * BaseTile::TileSize.y, 16.0f, 16.0f)) == Entity::InvalidId;
+}
+
+
 bool DungeonAreaGen::PlaceDownStairs(WorldArea& area, Rng& rng)
 {
     for (std::size_t i = 0; i < node_.GetChildrenCount(); ++i) {
         auto childNode = node_.GetChildNode(i);
 
         if (childNode && childNode->IsDirectory()) {
-            // try to create stairs for this node
-            // TODO less bruteforcey?!?!?!?
+            // create stairs on a random free walkable tile; one draw picks where to start looking from
             bool placedStair = false;
-            int tryCount = 0;
-
-            while (tryCount++ < 10000) {
-                auto desiredArea = sf::FloatRect(
-                    Helper::GenerateRandomInt<Rng, u32>(rng, 0, area.GetWidth() - 1) * BaseTile::TileSize.x,
-                    Helper::GenerateRandomInt<Rng, u32>(rng, 0, area.GetHeight() - 1) * BaseTile::TileSize.y,
-                    16.0f, 16.0f
-                    );
-
-                if (area.CheckEntRectangleWalkable(desiredArea) &&
-                    area.GetFirstWorldEntInRectangle<UnitEntity>(desiredArea) == Entity::InvalidId) {
-                    auto downstairEnt = area.GetEntity<DownStairEntity>(
-                        area.EmplaceEntity<DownStairEntity>(childNode->GetName()));
-                    
-                    if (downstairEnt) {
-                        downstairEnt->SetPosition(sf::Vector2f(desiredArea.left, desiredArea.top));
-                        placedStair = true;
-                        break;
-                    }
+            auto& walkableTiles = area.GetWalkableTiles();
+            u32 tileX, tileY;
+
+            if (!walkableTiles.empty() && area.FindWalkableTileFrom(
+                Helper::GenerateRandomInt<Rng, std::size_t>(rng, 0, walkableTiles.size() - 1), 1,
+                [this, &area](u32 x, u32 y) { return IsSpawnTileFree(area, x, y); }, &tileX, &tileY)) {
+                auto downstairEnt = area.GetEntity<DownStairEntity>(
+                    area.EmplaceEntity<DownStairEntity>(childNode->GetName()));
+
+                if (downstairEnt) {
+                    downstairEnt->SetPosition(sf::Vector2f(tileX * BaseTile::TileSize.x,
+                        tileY * BaseTile::TileSize.y));
+                    area.SetFsNodeEntity(childNode, downstairEnt->GetAssignedId());
+                    placedStair = true;
                 }
             }
 
@@ -540,68 +551,63 @@ bool DungeonAreaGen::PlaceChests(WorldArea& area, Rng& rng)
         auto childNode = node_.GetChildNode(i);
 
         if (childNode && !childNode->IsDirectory()) {
-            // try to create a chest for this node
-            // TODO less bruteforcey?!?!?!?
+            // create a chest on a random free walkable tile; one draw picks where to start looking from
             bool placedChest = false;
-            int tryCount = 0;
-
-            while (tryCount++ < 10000) {
-                auto desiredArea = sf::FloatRect(
-                    Helper::GenerateRandomInt<Rng, u32>(rng, 0, area.GetWidth() - 1) * BaseTile::TileSize.x,
-                    Helper::GenerateRandomInt<Rng, u32>(rng, 0, area.GetHeight() - 1) * BaseTile::TileSize.y,
-                    16.0f, 16.0f
-                    );
-
-                if (area.CheckEntRectangleWalkable(desiredArea) &&
-                    area.GetFirstWorldEntInRectangle<UnitEntity>(desiredArea) == Entity::InvalidId) {
-                    ChestType chestType;
-
-                    switch (Helper::GenerateRandomInt(rng, 0, 2)) {
-                    default:
-                        assert(!"Unknown chest type!");
-                        break;
+            auto& walkableTiles = area.GetWalkableTiles();
+            u32 tileX, tileY;
+
+            if (!walkableTiles.empty() && area.FindWalkableTileFrom(
+                Helper::GenerateRandomInt<Rng, std::size_t>(rng, 0, walkableTiles.size() - 1), 1,
+            [this, &area](u32 x, u32 y) { return IsSpawnTileFree(area, x, y); }, &tileX, &tileY)) {
+                ChestType chestType;
+
+                switch (Helper::GenerateRandomInt(rng, 0, 2)) {
+                default:
+                    assert(!"Unknown chest type!");
+                    break;
+
+                case 0:
+                    chestType = ChestType::RedChest;
+                    break;
+
+                case 1:
+                    chestType = ChestType::BlueChest;
+                    break;
+
+                case 2:
+                    chestType = ChestType::PurpleChest;
+                    break;
+                }
 
-                    case 0:
-                        chestType = ChestType::RedChest;
-                        break;
+                // choose drop table type
+                ChestDropTableType chestDropTable;
 
-                    case 1:
-                        chestType = ChestType::BlueChest;
-                        break;
+                switch (childNode->GetType()) {
+                case GameFilesystemNodeType::NullDevice:
+                    chestDropTable = ChestDropTableType::StoredItemsOnly;
+                    break;
 
-                    case 2:
-                        chestType = ChestType::PurpleChest;
-                        break;
-                    }
+                default:
+                    chestDropTable = ChestDropTableType::Normal;
+                }
 
-                    // choose drop table type
-                    ChestDropTableType chestDropTable;
+                auto chestEnt = area.GetEntity<ChestEntity>(area.EmplaceEntity<ChestEntity>(
+                    chestType, chestDropTable, childNode->GetName()));
 
+                if (chestEnt) {
+                    area.SetFsNodeEntity(childNode, chestEnt->GetAssignedId());
+
+                    // unique loot spawns
                     switch (childNode->GetType()) {
-                    case GameFilesystemNodeType::NullDevice:
-                        chestDropTable = ChestDropTableType::StoredItemsOnly;
+                    case GameFilesystemNodeType::ZeroDevice:
+                        // spawn the Zero Staff in this chest.
+                        chestEnt->GetItems().emplace_back(std::make_unique<MagicWeapon>(MagicWeaponType::ZeroStaff));
                         break;
-
-                    default:
-                        chestDropTable = ChestDropTableType::Normal;
                     }
 
-                    auto chestEnt = area.GetEntity<ChestEntity>(area.EmplaceEntity<ChestEntity>(
-                        chestType, chestDropTable, childNode->GetName()));
-
-                    if (chestEnt) {
-                        // unique loot spawns
-                        switch (childNode->GetType()) {
-                        case GameFilesystemNodeType::ZeroDevice:
-                            // spawn the Zero Staff in this chest.
-                            chestEnt->GetItems().emplace_back(std::make_unique<MagicWeapon>(MagicWeaponType::ZeroStaff));
-                            break;
-                        }
-
-                        chestEnt->SetPosition(sf::Vector2f(desiredArea.left, desiredArea.top));
-                        placedChest = true;
-                        break;
-                    }
+                    chestEnt->SetPosition(sf::Vector2f(tileX * BaseTile::TileSize.x,
+                        tileY * BaseTile::TileSize.y));
+                    placedChest = true;
                 }
             }
 
@@ -617,9 +623,8 @@ bool DungeonAreaGen::PlaceChests(WorldArea& area, Rng& rng)
 
 void DungeonAreaGen::ConfigureGenSettings()
 {
-    std::cout << "DungeonAreaGen - ConfigureGenSettings(); node '" << GameFilesystem::GetNodePathString(node_)
-        << "' has random identifier " << node_.GetRandomIdentifier() << " and " << node_.GetChildrenCount()
-        << " children.\n";
+    LOG_DEBUG("DungeonAreaGen - ConfigureGenSettings(); node '{}' has random identifier {} and {} children.",
+        GameFilesystem::LogNodePath(node_), node_.GetRandomIdentifier(), node_.GetChildrenCount());
 
     Rng rng(node_.GetRandomIdentifier());
 
@@ -646,27 +651,25 @@ void DungeonAreaGen::ConfigureGenSettings()
     passageGrowLengthMin_ = 4;
     passageGrowLengthMax_ = 6;
 
-    std::cout << "DungeonAreaGen - ConfigureGenSettings(); settings for dungeon area generation:\n";
-    std::cout << "\tgenSeed: " << genSeed_ << "\n";
-    std::cout << "\tgenIterations: " << genIterations_ << "\n";
-    std::cout << "\tgenMaxRetries: " << genMaxRetries_ << "\n";
-    std::cout << "\tfallbackRoomSize: (" << fallbackRoomWidth_ << " x " << fallbackRoomHeight_ << ")\n";
-    std::cout << "\tminStructureAmount: " << minStructureAmount_ << "\n";
-    std::cout << "\tmaxStructureAmount: " << maxStructureAmount_ << "\n";
-    std::cout << "\ttargetStructureAmount: " << targetStructureAmount_ << "\n";
-    std::cout << "\tstructureChanceAfterTargetMet: " << structureChanceAfterTargetMet_ << "\n";
-    std::cout << "\tfirstRoomWidth: (" << firstRoomWidthMin_ << ", " << firstRoomWidthMax_ << ")\n";
-    std::cout << "\totherRoomsWidth: (" << otherRoomsWidthMin_ << ", " << otherRoomsWidthMax_ << ")\n";
-    std::cout << "\troomPassageGrowAmount: (" << roomPassageGrowAmountMin_ << ", " << roomPassageGrowAmountMax_ << ")\n";
-    std::cout << "\tpassageRetryGrowAmount: (" << roomPassageGrowAmountMin_ << ", " << passageRetryGrowAmountMax_ << ")\n";
-    std::cout << "\tpassageGrowLength: (" << passageGrowLengthMin_ << ", " << passageGrowLengthMax_ << ")\n";
-    std::cout << "\n";
+    // split up so each message stays within the logger's argument limit
+    LOG_DEBUG("DungeonAreaGen - ConfigureGenSettings(); genSeed: {}, genIterations: {}, genMaxRetries: {}, "
+        "fallbackRoomSize: ({} x {})",
+        genSeed_, genIterations_, genMaxRetries_, fallbackRoomWidth_, fallbackRoomHeight_);
+    LOG_DEBUG("DungeonAreaGen - ConfigureGenSettings(); structureAmount: (min {}, max {}, target {}), "
+        "structureChanceAfterTargetMet: {}",
+        minStructureAmount_, maxStructureAmount_, targetStructureAmount_, structureChanceAfterTargetMet_);
+    LOG_DEBUG("DungeonAreaGen - ConfigureGenSettings(); firstRoomWidth: ({}, {}), otherRoomsWidth: ({}, {})",
+        firstRoomWidthMin_, firstRoomWidthMax_, otherRoomsWidthMin_, otherRoomsWidthMax_);
+    LOG_DEBUG("DungeonAreaGen - ConfigureGenSettings(); roomPassageGrowAmount: ({}, {}), "
+        "passageRetryGrowAmount: ({}, {}), passageGrowLength: ({}, {})",
+        roomPassageGrowAmountMin_, roomPassageGrowAmountMax_, passageRetryGrowAmountMin_, passageRetryGrowAmountMax_,
+        passageGrowLengthMin_, passageGrowLengthMax_);
 }
 
 
 bool DungeonAreaGen::GenerateFallbackArea(WorldArea& area, Rng& rng)
 {
-    std::cerr << "DungeonAreaGen: WARN - Generating fallback area!!!\n";
+    LOG_WARN("DungeonAreaGen: Generating fallback area!!!");
     if (!GenerateCenterRoom(area, rng, fallbackRoomWidth_, fallbackRoomHeight_)) {
         return false;
     }
@@ -689,14 +692,14 @@ bool DungeonAreaGen::GenerateArea(WorldArea& area, Rng& rng)
                 Helper::GenerateRandomInt<Rng, u32>(rng, firstRoomWidthMin_, firstRoomWidthMax_),
                 Helper::GenerateRandomInt<Rng, u32>(rng, firstRoomWidthMin_, firstRoomWidthMax_)
                 )) {
-                std::cout << "DungeonAreaGen: WARN - could not generate starting room!!!\n";
+                LOG_WARN("DungeonAreaGen: could not generate starting room!!!");
                 assert(!"Failed to generate starting room!!!");
                 return false;
             }
 
             // Place start point
             if (!AddPlayerStart(area)) {
-                std::cerr << "DungeonAreaGen: WARN - could not add player start!\n";
+                LOG_WARN("DungeonAreaGen: could not add player start!");
                 return false;
             }
         }
@@ -722,15 +725,15 @@ bool DungeonAreaGen::GenerateArea(WorldArea& area, Rng& rng)
 
     // check if we met the min structure requirement, fail if we didn't.
     if (currentStructureCount_ < minStructureAmount_) {
-        std::cerr << "DungeonAreaGen: WARN - Failed to meet minimum structure count! ("
-            << currentStructureCount_ << " < " << minStructureAmount_ << ")\n";
+        LOG_WARN("DungeonAreaGen: Failed to meet minimum structure count! ({} < {})",
+            currentStructureCount_, minStructureAmount_);
         
         return false;
     }
     
     if (currentStructureCount_ < targetStructureAmount_) {
-        std::cout <<  "DungeonAreaGen: WARN - Target structure count wasn't met... ("
-            << currentStructureCount_ << " < " << targetStructureAmount_ << ")\n";
+        LOG_WARN("DungeonAreaGen: Target structure count wasn't met... ({} < {})",
+            currentStructureCount_, targetStructureAmount_);
     }
 
     // place down stairs and chests
@@ -744,8 +747,9 @@ bool DungeonAreaGen::GenerateArea(WorldArea& area, Rng& rng)
 
 std::unique_ptr<WorldArea> DungeonAreaGen::GenerateNewArea(u32 w, u32 h)
 {
-    std::cout << "DungeonAreaGen: Generating new area for node '" << GameFilesystem::GetNodePathString(node_)
-        << "'\n";
+    PROFILE_ZONE("DungeonAreaGen::GenerateNewArea");
+
+    LOG_DEBUG("DungeonAreaGen: Generating new area for node '{}'", GameFilesystem::LogNodePath(node_));
 
     Rng rng(genSeed_);
     std::unique_ptr<WorldArea> area;
@@ -759,29 +763,32 @@ std::unique_ptr<WorldArea> DungeonAreaGen::GenerateNewArea(u32 w, u32 h)
         currentStructureCount_ = 0;
         activePassages_.clear();
         newActivePassages_.clear();
+        genRegions_.clear();
+        genRegionCount_ = 0;
 
         // generate fallback area if we've used all our retries
         if (genTryCount > genMaxRetries_) {
-            std::cerr << "DungeonAreaGen: WARN - Failed to generate area after " << genMaxRetries_
-                << " retries - generating fallback area!!\n";
+            LOG_WARN("DungeonAreaGen: Failed to generate area after {} retries - generating fallback area!!",
+                genMaxRetries_);
 
             // we've used up all our retries, fallback!
             if (!GenerateFallbackArea(*area, rng)) {
-                std::cout << "DungeonAreaGen: ERROR - FAILED TO GENERATE FALLBACK AREA!\n";
+                LOG_ERROR("DungeonAreaGen: FAILED TO GENERATE FALLBACK AREA!");
                 assert(!"Failed to generate fallback area!!!!");
                 return nullptr;
             }
 
-            std::cout << "DungeonAreaGen: Finished generating FALLBACK area\n";
+            LOG_INFO("DungeonAreaGen: Finished generating FALLBACK area");
             break;
         }
         
         // generate area
         if (GenerateArea(*area, rng)) {
-            std::cout << "DungeonAreaGen: Finished area generation: " << currentStructureCount_ << " structure(s) [excludes start room]\n";
+            LOG_DEBUG("DungeonAreaGen: Finished area generation: {} structure(s) [excludes start room]", currentStructureCount_);
             break;
         }
     }
 
+    area->SetNavGraph(std::make_unique<NavGraph>(*area, genRegions_));
 	return area;
 }
\ No newline at end of file
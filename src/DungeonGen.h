@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "Types.h"
 #include "GameFilesystem.h"
 #include "World.h"
@@ -61,6 +63,16 @@ class DungeonAreaGen
 
     int currentStructureCount_;
 
+    // which room or straight piece of passage last placed each floor tile, keyed by y * width + x, for the
+    // area's nav graph
+    std::unordered_map<u32, u32> genRegions_;
+    u32 genRegionCount_;
+
+    inline void SetGenRegion(const WorldArea& area, u32 x, u32 y, u32 region)
+    {
+        genRegions_[y * area.GetWidth() + x] = region;
+    }
+
     bool CheckRoomRectanglePlaceable(WorldArea& area, u32 topX, u32 topY, u32 w, u32 h) const;
 	bool PlaceEmptyRoom(WorldArea& area, Rng& rng, u32 topX, u32 topY, u32 w, u32 h, bool goldRoom = false);
     bool GenerateRoom(WorldArea& area, Rng& rng, u32 topX, u32 topY, u32 w, u32 h, bool goldRoom = false);
@@ -81,6 +93,7 @@ class DungeonAreaGen
     bool GenerateFallbackArea(WorldArea& area, Rng& rng);
     bool GenerateArea(WorldArea& area, Rng& rng);
 
+    bool IsSpawnTileFree(const WorldArea& area, u32 x, u32 y) const;
     bool PlaceDownStairs(WorldArea& area, Rng& rng);
     bool PlaceChests(WorldArea& area, Rng& rng);
 
@@ -1,6 +1,8 @@
 #include "Enemy.h"
 
 #include <cassert>
+#include <cmath>
+#include <iterator>
 
 #include <SFML/Graphics/RectangleShape.hpp>
 
@@ -13,6 +15,7 @@ Enemy::Enemy() :
 AliveEntity()
 {
     SetSize(sf::Vector2f(16.0f, 16.0f));
+    SetCollisionLayer(CollisionLayer::Enemy);
 }
 
 
@@ -28,7 +31,7 @@ u32 Enemy::Damage(u32 damageAmount, DamageType type)
 }
 
 
-void Enemy::Render(sf::RenderTarget& target)
+void Enemy::Render(CountingRenderTarget& target)
 {
     auto area = GetAssignedArea();
 
@@ -92,6 +95,7 @@ void Enemy::Render(sf::RenderTarget& target)
 DungeonGuardian::DungeonGuardian() :
 Enemy(),
 form_(DungeonGuardianForm::MagicForm),
+formSoundTimerTag_(0),
 rot_(Helper::GenerateRandomReal(0.0f, 360.0f)),
 handleDeathAnim_(false)
 {
@@ -101,7 +105,7 @@ handleDeathAnim_(false)
     ResetStats(); 
     ChangeForm(DungeonGuardianForm::MagicForm);
 
-    GameAssets::Get().bossSpawnSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().bossSpawnSoundBuffer);
 }
 
 
@@ -130,16 +134,46 @@ void DungeonGuardian::SetupAnimations()
 
 void DungeonGuardian::ResetStats(float difficultyMul)
 {
-    stats_ = std::make_unique<AliveStats>();
+    stats_.Reset();
 
-    stats_->SetMaxHealth(1500 + static_cast<u32>(1000 * difficultyMul));
-    stats_->SetMeleeAttack(90 + static_cast<u32>(40 * difficultyMul));
-    stats_->SetMagicAttack(90 + static_cast<u32>(50 * difficultyMul));
-    stats_->SetMeleeDefence(40 + static_cast<u32>(40 * difficultyMul));
-    stats_->SetMagicDefence(100 + static_cast<u32>(145 * difficultyMul));
+    stats_.SetMaxHealth(1500 + static_cast<u32>(1000 * difficultyMul));
+    stats_.SetMeleeAttack(90 + static_cast<u32>(40 * difficultyMul));
+    stats_.SetMagicAttack(90 + static_cast<u32>(50 * difficultyMul));
+    stats_.SetMeleeDefence(40 + static_cast<u32>(40 * difficultyMul));
+    stats_.SetMagicDefence(100 + static_cast<u32>(145 * difficultyMul));
 
-    stats_->SetHealth(stats_->GetMaxHealth());
-    SetStats(stats_.get());
+    stats_.SetHealth(stats_.GetMaxHealth());
+    SetStats(&stats_);
+}
+
+
+void DungeonGuardian::OnAssignedToArea()
+{
+    stats_.MoveToStore(GetAssignedArea()->GetAliveStatsStore());
+    StartTimer(formSoundTimerTag_, sf::seconds(1.0f));
+}
+
+
+void DungeonGuardian::OnTimer(u32 tag)
+{
+    // form sound timer NOTE: (only used for melee form right now, may or may not be used)
+    // for other forms. timers started before the last form change are stale
+    if (tag != formSoundTimerTag_) {
+        return;
+    }
+
+    auto area = GetAssignedArea();
+
+    if (area && !area->IsTickingInBackground()) {
+        switch (form_) {
+        case DungeonGuardianForm::MeleeForm:
+            AudioQueue::Get().PlayAt(GameAssets::Get().bossSwordSoundBuffer, area, GetCenterPosition(),
+                SoundPriority::Low);
+            break;
+        }
+    }
+
+    StartTimer(formSoundTimerTag_, sf::seconds(0.8f));
 }
 
 
@@ -196,7 +230,7 @@ void DungeonGuardian::ChangeForm(DungeonGuardianForm newForm)
     }
 
     form_ = newForm;
-    formSoundTimeLeft_ = sf::seconds(1.0f);
+    StartTimer(++formSoundTimerTag_, sf::seconds(1.0f));
     NewFormAction();
     ResetAnimations();
 }
@@ -233,7 +267,7 @@ void DungeonGuardian::PlayerKilled()
         stats->ApplyHealing(std::max<u32>(100, 
             Helper::GenerateRandomInt<u32>(stats->GetMaxHealth() / 25, stats->GetMaxHealth() / 5)));
 
-        GameAssets::Get().drainSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().drainSoundBuffer, GetAssignedArea(), GetCenterPosition());
     }
 
     // schedule next action
@@ -243,12 +277,51 @@ void DungeonGuardian::PlayerKilled()
 }
 
 
+void DungeonGuardian::FireSmokeVolley(WorldArea& area, const sf::Vector2f& center, u32 minDamage, u32 maxDamage)
+{
+    int numProjectiles = 12;
+    auto projAngleRadsOffset = Helper::GenerateRandomReal(0.0f, 2.0f * PI);
+
+    for (int i = 0; i < numProjectiles; ++i) {
+        auto projAngleRads = 2.0f * PI * (i / static_cast<float>(numProjectiles)) + projAngleRadsOffset;
+        sf::Vector2f projectileDir(cosf(projAngleRads), sinf(projAngleRads));
+
+        auto projectile = area.GetEntity<ProjectileEntity>(
+            area.EmplaceEntity<ProjectileEntity>(ProjectileType::EnemySmoke, projectileDir));
+        assert(projectile);
+
+        projectile->SetCenterPosition(center + projectileDir * 8.0f);
+        projectile->SetDamage(Helper::GenerateRandomInt<u32>(minDamage, maxDamage));
+
+        AudioQueue::Get().PlayAt(GameAssets::Get().smokeSoundBuffer, &area, center);
+    }
+}
+
+
+void DungeonGuardian::FireDeathOrbBurst(WorldArea& area, const sf::Vector2f& center)
+{
+    int numProjectiles = 20;
+
+    for (int i = 0; i < numProjectiles; ++i) {
+        auto projAngleRads = 2.0f * PI * (i / static_cast<float>(numProjectiles));
+        sf::Vector2f projectileDir(cosf(projAngleRads), sinf(projAngleRads));
+
+        auto projectile = area.GetEntity<ProjectileEntity>(
+            area.EmplaceEntity<ProjectileEntity>(ProjectileType::EffectOrb, projectileDir));
+        assert(projectile);
+
+        projectile->SetCenterPosition(center + projectileDir * 12.0f);
+    }
+}
+
+
 void DungeonGuardian::Tick()
 {
     auto area = GetAssignedArea();
     auto stats = GetStats();
 
-    if (!area || !stats) {
+    // the fight waits for the player to come back
+    if (!area || !stats || area->IsTickingInBackground()) {
         return;
     }
 
@@ -260,7 +333,7 @@ void DungeonGuardian::Tick()
             actionTimeLeft_ = sf::seconds(3.0f);
             handleDeathAnim_ = true;
 
-            GameAssets::Get().bossDyingSound.play();
+            AudioQueue::Get().PlayAt(GameAssets::Get().bossDyingSoundBuffer, GetAssignedArea(), GetCenterPosition());
         }
     }
 
@@ -300,29 +373,13 @@ void DungeonGuardian::Tick()
                     projectile->SetCenterPosition(GetCenterPosition() + projectileDir * 8.0f);
                     projectile->SetDamage(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()));
 
-                    GameAssets::Get().magicFireSound.play();
+                    AudioQueue::Get().PlayAt(GameAssets::Get().magicFireSoundBuffer, GetAssignedArea(), GetCenterPosition());
                     break;
                 }
 
                 case DungeonGuardianForm::SmokeForm:
                     // fire projectiles in lots of directions around boss
-                    int numProjectiles = 12;
-                    auto projAngleRadsOffset = Helper::GenerateRandomReal(0.0f, 2.0f * PI);
-
-                    for (int i = 0; i < numProjectiles; ++i) {
-                        auto projAngleRads = 2.0f * PI * (i / static_cast<float>(numProjectiles)) + projAngleRadsOffset;
-                        sf::Vector2f projectileDir(cosf(projAngleRads), sinf(projAngleRads));
-
-                        auto projectile = area->GetEntity<ProjectileEntity>(
-                            area->EmplaceEntity<ProjectileEntity>(ProjectileType::EnemySmoke, projectileDir));
-                        assert(projectile);
-
-                        projectile->SetCenterPosition(GetCenterPosition() + projectileDir * 8.0f);
-                        projectile->SetDamage(Helper::GenerateRandomInt<u32>(stats->GetMagicAttack() / 4,
-                            stats->GetMagicAttack()));
-
-                        GameAssets::Get().smokeSound.play();
-                    }
+                    FireSmokeVolley(*area, GetCenterPosition(), stats->GetMagicAttack() / 4, stats->GetMagicAttack());
                     break;
                 }
 
@@ -334,7 +391,8 @@ void DungeonGuardian::Tick()
             case DungeonGuardianForm::MeleeForm:
             case DungeonGuardianForm::SmokeForm:
                 moveDir_ = Helper::GetUnitVector(
-                    moveDir_ + 0.1f * Helper::GetUnitVector(playerAggro->GetCenterPosition() - GetCenterPosition()));
+                    moveDir_ + 0.1f * WorldVectorToFloat(area->GetChaseDirection(GetCenterPosition(),
+                    playerAggro->GetCenterPosition(), &chasePath_)));
                 break;
 
             case DungeonGuardianForm::MagicForm:
@@ -347,12 +405,7 @@ void DungeonGuardian::Tick()
         Move(moveDir_ * stats->GetMoveSpeed() * Game::FrameTimeStep.asSeconds());
 
         // damage players touching us depending on form
-        auto touchingPlayers = area->GetAllWorldEntsInRectangle<PlayerEntity>(GetRectangle());
-
-        for (auto pid : touchingPlayers) {
-            auto player = area->GetEntity<PlayerEntity>(pid);
-            assert(player);
-
+        area->ForEachTouching<PlayerEntity>(*this, [&](PlayerEntity* player) {
             if (player->GetStats() && player->GetStats()->IsAlive() && !player->HasInvincibility()) {
                 switch (form_) {
                 case DungeonGuardianForm::MeleeForm:
@@ -370,7 +423,7 @@ void DungeonGuardian::Tick()
                 }
                 player->MoveWithCollision(moveDir_ * 5.0f); // push player
             }
-        }
+        });
 
         // tick animss
         TickAnimations();
@@ -402,7 +455,7 @@ void DungeonGuardian::Tick()
                 NewFormAction();
             }
 
-            GameAssets::Get().bossActionSound.play();
+            AudioQueue::Get().PlayAt(GameAssets::Get().bossActionSoundBuffer, GetAssignedArea(), GetCenterPosition());
 
             // tp in rad around player if player exists
             auto center = playerAggro ? playerAggro->GetCenterPosition() : GetCenterPosition();
@@ -412,20 +465,9 @@ void DungeonGuardian::Tick()
         else {
             // handle death and explode into orbs for effect
             // and mark ent delete
-            int numProjectiles = 20;
+            FireDeathOrbBurst(*area, GetCenterPosition());
 
-            for (int i = 0; i < numProjectiles; ++i) {
-                auto projAngleRads = 2.0f * PI * (i / static_cast<float>(numProjectiles));
-                sf::Vector2f projectileDir(cosf(projAngleRads), sinf(projAngleRads));
-
-                auto projectile = area->GetEntity<ProjectileEntity>(
-                    area->EmplaceEntity<ProjectileEntity>(ProjectileType::EffectOrb, projectileDir));
-                assert(projectile);
-
-                projectile->SetCenterPosition(GetCenterPosition() + projectileDir * 12.0f);
-            }
-
-            GameAssets::Get().bossDeadSound.play();
+            AudioQueue::Get().PlayAt(GameAssets::Get().bossDeadSoundBuffer, GetAssignedArea(), GetCenterPosition());
             Game::Get().GetDirector().BossDefeated();
 
             MarkForDeletion();
@@ -435,25 +477,10 @@ void DungeonGuardian::Tick()
     else {
         actionTimeLeft_ -= Game::FrameTimeStep;
     }
-
-    // handle form sound timer NOTE: (only used for melee form right now, may or may not be used)
-    // for other forms
-    if (formSoundTimeLeft_ <= sf::Time::Zero) {
-        switch (form_) {
-        case DungeonGuardianForm::MeleeForm:
-            GameAssets::Get().bossSwordSound.play();
-            break;
-        }
-
-        formSoundTimeLeft_ = sf::seconds(0.8f);
-    }
-    else {
-        formSoundTimeLeft_ -= Game::FrameTimeStep;
-    }
 }
 
 
-void DungeonGuardian::Render(sf::RenderTarget& target)
+void DungeonGuardian::Render(CountingRenderTarget& target)
 {
     auto area = GetAssignedArea();
 
@@ -525,7 +552,11 @@ void DungeonGuardian::Render(sf::RenderTarget& target)
 BasicEnemy::BasicEnemy(EnemyType enemyType) :
 Enemy(),
 enemyType_(enemyType),
-droppedItems_(false)
+wanderDue_(true),
+moveDir_(),
+aggroPlayerId_(InvalidId),
+droppedItems_(false),
+hasPreparedMove_(false)
 {
     if (enemyType_ != EnemyType::SkeletonBasic &&
         enemyType_ != EnemyType::GreenBlobBasic &&
@@ -624,7 +655,7 @@ void BasicEnemy::SetupAnimations()
 
 void BasicEnemy::ResetStats(float difficultyMul)
 {
-    stats_ = std::make_unique<AliveStats>();
+    stats_.Reset();
 
     switch (enemyType_) {
     default:
@@ -632,89 +663,96 @@ void BasicEnemy::ResetStats(float difficultyMul)
         break;
 
     case EnemyType::SkeletonBasic:
-        stats_->SetMaxHealth(500 + static_cast<u32>(180 * difficultyMul));
-        stats_->SetMoveSpeed(42.5f);
-        stats_->SetMeleeAttack(90 + static_cast<u32>(40 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(30 + static_cast<u32>(30 * difficultyMul));
-        stats_->SetMagicDefence(0);
+        stats_.SetMaxHealth(500 + static_cast<u32>(180 * difficultyMul));
+        stats_.SetMoveSpeed(42.5f);
+        stats_.SetMeleeAttack(90 + static_cast<u32>(40 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(30 + static_cast<u32>(30 * difficultyMul));
+        stats_.SetMagicDefence(0);
         break;
 
     case EnemyType::GreenBlobBasic:
-        stats_->SetMaxHealth(150 + static_cast<u32>(80 * difficultyMul));
-        stats_->SetMoveSpeed(40.0f);
-        stats_->SetMeleeAttack(65 + static_cast<u32>(14 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(static_cast<u32>(12 * difficultyMul));
-        stats_->SetMagicDefence(static_cast<u32>(12 * difficultyMul));
+        stats_.SetMaxHealth(150 + static_cast<u32>(80 * difficultyMul));
+        stats_.SetMoveSpeed(40.0f);
+        stats_.SetMeleeAttack(65 + static_cast<u32>(14 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(static_cast<u32>(12 * difficultyMul));
+        stats_.SetMagicDefence(static_cast<u32>(12 * difficultyMul));
         break;
 
     case EnemyType::BlueBlobBasic:
-        stats_->SetMaxHealth(185 + static_cast<u32>(100 * difficultyMul));
-        stats_->SetMoveSpeed(43.5f);
-        stats_->SetMeleeAttack(70 + static_cast<u32>(22 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(static_cast<u32>(20 * difficultyMul));
-        stats_->SetMagicDefence(static_cast<u32>(20 * difficultyMul));
+        stats_.SetMaxHealth(185 + static_cast<u32>(100 * difficultyMul));
+        stats_.SetMoveSpeed(43.5f);
+        stats_.SetMeleeAttack(70 + static_cast<u32>(22 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(static_cast<u32>(20 * difficultyMul));
+        stats_.SetMagicDefence(static_cast<u32>(20 * difficultyMul));
         break;
 
     case EnemyType::RedBlobBasic:
-        stats_->SetMaxHealth(200 + static_cast<u32>(125 * difficultyMul));
-        stats_->SetMoveSpeed(47.0f);
-        stats_->SetMeleeAttack(75 + static_cast<u32>(30 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(static_cast<u32>(28 * difficultyMul));
-        stats_->SetMagicDefence(static_cast<u32>(28 * difficultyMul));
+        stats_.SetMaxHealth(200 + static_cast<u32>(125 * difficultyMul));
+        stats_.SetMoveSpeed(47.0f);
+        stats_.SetMeleeAttack(75 + static_cast<u32>(30 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(static_cast<u32>(28 * difficultyMul));
+        stats_.SetMagicDefence(static_cast<u32>(28 * difficultyMul));
         break;
 
     case EnemyType::PinkBlobBasic:
-        stats_->SetMaxHealth(230 + static_cast<u32>(170 * difficultyMul));
-        stats_->SetMoveSpeed(50.5f);
-        stats_->SetMeleeAttack(80 + static_cast<u32>(38 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(static_cast<u32>(36 * difficultyMul));
-        stats_->SetMagicDefence(static_cast<u32>(36 * difficultyMul));
+        stats_.SetMaxHealth(230 + static_cast<u32>(170 * difficultyMul));
+        stats_.SetMoveSpeed(50.5f);
+        stats_.SetMeleeAttack(80 + static_cast<u32>(38 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(static_cast<u32>(36 * difficultyMul));
+        stats_.SetMagicDefence(static_cast<u32>(36 * difficultyMul));
         break;
 
     case EnemyType::GhostBasic:
-        stats_->SetMaxHealth(600 + static_cast<u32>(200 * difficultyMul));
-        stats_->SetMoveSpeed(32.5f);
-        stats_->SetMeleeAttack(100 + static_cast<u32>(50 * difficultyMul));
-        stats_->SetMagicAttack(0);
-        stats_->SetMeleeDefence(50 + static_cast<u32>(50 * difficultyMul));
-        stats_->SetMagicDefence(0);
+        stats_.SetMaxHealth(600 + static_cast<u32>(200 * difficultyMul));
+        stats_.SetMoveSpeed(32.5f);
+        stats_.SetMeleeAttack(100 + static_cast<u32>(50 * difficultyMul));
+        stats_.SetMagicAttack(0);
+        stats_.SetMeleeDefence(50 + static_cast<u32>(50 * difficultyMul));
+        stats_.SetMagicDefence(0);
         break;
 
     case EnemyType::MagicFlameBasic:
-        stats_->SetMaxHealth(50 + static_cast<u32>(45 * difficultyMul));
-        stats_->SetMoveSpeed(67.5f);
-        stats_->SetMeleeAttack(0);
-        stats_->SetMagicAttack(115 + static_cast<u32>(55 * difficultyMul));
-        stats_->SetMeleeDefence(60 + static_cast<u32>(62 * difficultyMul));
-        stats_->SetMagicDefence(20 + static_cast<u32>(8 * difficultyMul));
+        stats_.SetMaxHealth(50 + static_cast<u32>(45 * difficultyMul));
+        stats_.SetMoveSpeed(67.5f);
+        stats_.SetMeleeAttack(0);
+        stats_.SetMagicAttack(115 + static_cast<u32>(55 * difficultyMul));
+        stats_.SetMeleeDefence(60 + static_cast<u32>(62 * difficultyMul));
+        stats_.SetMagicDefence(20 + static_cast<u32>(8 * difficultyMul));
         break;
 
     case EnemyType::AncientWizardBasic:
-        stats_->SetMaxHealth(275 + static_cast<u32>(135 * difficultyMul));
-        stats_->SetMoveSpeed(40.0f);
-        stats_->SetMeleeAttack(65 + static_cast<u32>(35 * difficultyMul));
-        stats_->SetMagicAttack(90 + static_cast<u32>(48 * difficultyMul));
-        stats_->SetMeleeDefence(20 + static_cast<u32>(20 * difficultyMul));
-        stats_->SetMagicDefence(100 + static_cast<u32>(150 * difficultyMul));
+        stats_.SetMaxHealth(275 + static_cast<u32>(135 * difficultyMul));
+        stats_.SetMoveSpeed(40.0f);
+        stats_.SetMeleeAttack(65 + static_cast<u32>(35 * difficultyMul));
+        stats_.SetMagicAttack(90 + static_cast<u32>(48 * difficultyMul));
+        stats_.SetMeleeDefence(20 + static_cast<u32>(20 * difficultyMul));
+        stats_.SetMagicDefence(100 + static_cast<u32>(150 * difficultyMul));
         break;
 
     case EnemyType::DarkWizardBasic:
-        stats_->SetMaxHealth(275 + static_cast<u32>(135 * difficultyMul));
-        stats_->SetMoveSpeed(33.5f);
-        stats_->SetMeleeAttack(65 + static_cast<u32>(35 * difficultyMul));
-        stats_->SetMagicAttack(90 + static_cast<u32>(48 * difficultyMul));
-        stats_->SetMeleeDefence(20 + static_cast<u32>(20 * difficultyMul));
-        stats_->SetMagicDefence(90 + static_cast<u32>(125 * difficultyMul));
+        stats_.SetMaxHealth(275 + static_cast<u32>(135 * difficultyMul));
+        stats_.SetMoveSpeed(33.5f);
+        stats_.SetMeleeAttack(65 + static_cast<u32>(35 * difficultyMul));
+        stats_.SetMagicAttack(90 + static_cast<u32>(48 * difficultyMul));
+        stats_.SetMeleeDefence(20 + static_cast<u32>(20 * difficultyMul));
+        stats_.SetMagicDefence(90 + static_cast<u32>(125 * difficultyMul));
         break;
     }
 
-    stats_->SetHealth(stats_->GetMaxHealth());
-    SetStats(stats_.get());
+    stats_.SetHealth(stats_.GetMaxHealth());
+    SetStats(&stats_);
+}
+
+
+void BasicEnemy::OnAssignedToArea()
+{
+    stats_.MoveToStore(GetAssignedArea()->GetAliveStatsStore());
+    EnrollThinker();
 }
 
 
@@ -749,14 +787,15 @@ float BasicEnemy::GetAggroDistance() const
 void BasicEnemy::NewWander()
 {
     if (Helper::GenerateRandomBool(0.5)) {
-        moveDir_ = sf::Vector2f();
+        moveDir_ = WorldVector();
     }
     else {
-        moveDir_ = sf::Vector2f(Helper::GenerateRandomBool(0.5) ? 1.0f : -1.0f,
-            Helper::GenerateRandomBool(0.5) ? 1.0f : -1.0f);
+        moveDir_ = WorldVectorFromFloat(sf::Vector2f(Helper::GenerateRandomBool(0.5) ? 1.0f : -1.0f,
+            Helper::GenerateRandomBool(0.5) ? 1.0f : -1.0f));
     }
 
-    nextWanderMoveTime_ = sf::seconds(Helper::GenerateRandomReal(1.0f, 4.0f));
+    wanderDue_ = false;
+    StartTimer(0, sf::seconds(Helper::GenerateRandomReal(1.0f, 4.0f)));
 }
 
 
@@ -1084,89 +1123,201 @@ void BasicEnemy::HandleDropItems()
 }
 
 
-void BasicEnemy::Tick()
+WorldVector BasicEnemy::GetMoveThisTick() const
 {
     auto stats = GetStats();
+    return stats ? ScaleWorldVector(moveDir_, stats->GetMoveSpeed(), GetTickTimeStep().asSeconds()) : WorldVector();
+}
+
+
+EntityId BasicEnemy::FindAggroPlayer(const sf::Vector2f& center)
+{
     auto area = GetAssignedArea();
+    assert(area);
 
-    if (stats && area) {
-        if (stats->IsAlive()) {
-            MoveWithCollision(moveDir_ * stats->GetMoveSpeed() * Game::FrameTimeStep.asSeconds());
+    // closest alive player in aggro range that we can see or walk to
+    aggroScratch_.clear();
+    area->GetWorldEntitiesInRange<PlayerEntity>(center, GetAggroDistance(), std::back_inserter(aggroScratch_));
 
-            // check if player is in aggro range and aggro on player if they are
-            auto closePlayers = area->GetWorldEntitiesInRange<PlayerEntity>(GetCenterPosition(), GetAggroDistance());
-            float playerDistSq = GetAggroDistance() * GetAggroDistance() + 1.0f;
-            PlayerEntity* playerAggro = nullptr;
+    float playerDistSq = GetAggroDistance() * GetAggroDistance() + 1.0f;
+    EntityId playerAggroId = InvalidId;
 
-            for (auto pinfo : closePlayers) {
-                auto player = area->GetEntity<PlayerEntity>(pinfo.first);
-                assert(player);
+    // the flow field only leads to the nearest player, but it's good enough to tell if one's within reach
+    auto flowDist = area->GetFlowFieldDistance(center);
+    bool inFlowReach = flowDist != WorldArea::FlowFieldUnreached &&
+        flowDist * std::max(BaseTile::TileSize.x, BaseTile::TileSize.y) <= GetAggroDistance();
 
-                if (player->GetStats() && player->GetStats()->IsAlive() && pinfo.second < playerDistSq) {
-                    playerDistSq = pinfo.second;
-                    playerAggro = player;
-                }
-            }
+    for (auto& playerInfo : aggroScratch_) {
+        auto player = static_cast<const WorldArea*>(area)->GetEntity<PlayerEntity>(playerInfo.first);
 
-            if (playerAggro) {
-                // aggro on this player
-                moveDir_ = Helper::GetUnitVector(playerAggro->GetCenterPosition() - GetCenterPosition());
+        if (player->GetStats() && player->GetStats()->IsAlive() && playerInfo.second < playerDistSq &&
+            (inFlowReach || area->HasLineOfSight(center, player->GetCenterPosition()))) {
+            playerDistSq = playerInfo.second;
+            playerAggroId = playerInfo.first;
+        }
+    }
 
-                // chance to shoot player if aggro'd on them
-                if (enemyType_ == EnemyType::AncientWizardBasic &&
-                    Helper::GenerateRandomBool(0.3125f * Game::FrameTimeStep.asSeconds())) {
-                    auto projectileDir = moveDir_ + sf::Vector2f(Helper::GenerateRandomReal(-0.2f, 0.2f),
-                        Helper::GenerateRandomReal(-0.2f, 0.2f));
+    return playerAggroId;
+}
 
-                    auto projectile = area->GetEntity<ProjectileEntity>(
-                        area->EmplaceEntity<ProjectileEntity>(ProjectileType::EnemyMagicWave, projectileDir));
-                    assert(projectile);
 
-                    // push player and fire projectile
-                    projectile->SetCenterPosition(GetCenterPosition() + projectileDir * 8.0f);
-                    projectile->SetDamage(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()));
+bool BasicEnemy::GetSimLodInfo(sf::Vector2f& outPos, float& outFullRateDistance) const
+{
+    // the dead still need a tick to drop their items
+    if (!GetStats() || !GetStats()->IsAlive()) {
+        return false;
+    }
 
-                    GameAssets::Get().waveSound.play();
-                }
-                else if (enemyType_ == EnemyType::DarkWizardBasic &&
-                    Helper::GenerateRandomBool(0.215f * Game::FrameTimeStep.asSeconds())) {
+    // full rate anywhere we could aggro, so reduced rate ticks never need to check for players
+    outPos = GetCenterPosition();
+    outFullRateDistance = GetAggroDistance();
+    return true;
+}
 
-                    auto damageEffect = area->GetEntity<DamageEffectEntity>(area->EmplaceEntity<DamageEffectEntity>(
-                        DamageEffectType::EnemyBlackFlame, sf::seconds(0.5f)));
-                    damageEffect->SetCenterPosition(playerAggro->GetCenterPosition());
 
-                    // push player and damage them
-                    playerAggro->Attack(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()), DamageType::Magic);
-                    playerAggro->MoveWithCollision(sf::Vector2f(Helper::GenerateRandomReal(-8.0f, 8.0f),
-                        Helper::GenerateRandomReal(-8.0f, 8.0f)));
+PlayerEntity* BasicEnemy::GetAliveAggroPlayer() const
+{
+    auto area = GetAssignedArea();
+    auto player = area ? area->GetEntity<PlayerEntity>(aggroPlayerId_) : nullptr;
 
-                    GameAssets::Get().blastSound.play();
-                }
+    return player && player->GetStats() && player->GetStats()->IsAlive() ? player : nullptr;
+}
+
+
+void BasicEnemy::Think()
+{
+    auto stats = GetStats();
+    auto area = GetAssignedArea();
+
+    auto thinkTime = sinceThink_;
+    sinceThink_ = sf::Time::Zero;
+
+    if (!stats || !area || !stats->IsAlive()) {
+        aggroPlayerId_ = InvalidId;
+        return;
+    }
+
+    // pick who to chase; Tick() keeps after them until the next think
+    aggroPlayerId_ = FindAggroPlayer(GetCenterPosition());
+    auto playerAggro = GetAliveAggroPlayer();
+
+    if (!playerAggro) {
+        return;
+    }
+
+    // chance to shoot player if aggro'd on them & we can see them (we may only be chasing their way);
+    // the odds are those of the per frame chance coming up at least once in the frames since our last think
+    auto thinkFrames = thinkTime.asSeconds() / Game::FrameTimeStep.asSeconds();
+    auto getThinkChance = [&](double chancePerSecond) {
+        return 1.0 - std::pow(1.0 - chancePerSecond * Game::FrameTimeStep.asSeconds(), thinkFrames);
+    };
+
+    if (enemyType_ == EnemyType::AncientWizardBasic &&
+        Helper::GenerateRandomBool(getThinkChance(0.3125)) &&
+        area->HasLineOfSight(GetCenterPosition(), playerAggro->GetCenterPosition())) {
+        auto dirToPlayer = Helper::GetUnitVector(playerAggro->GetCenterPosition() - GetCenterPosition());
+        auto projectileDir = dirToPlayer + sf::Vector2f(Helper::GenerateRandomReal(-0.2f, 0.2f),
+            Helper::GenerateRandomReal(-0.2f, 0.2f));
+
+        auto projectile = area->GetEntity<ProjectileEntity>(
+            area->EmplaceEntity<ProjectileEntity>(ProjectileType::EnemyMagicWave, projectileDir));
+        assert(projectile);
+
+        // push player and fire projectile
+        projectile->SetCenterPosition(GetCenterPosition() + projectileDir * 8.0f);
+        projectile->SetDamage(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()));
+
+        AudioQueue::Get().PlayAt(GameAssets::Get().waveSoundBuffer, GetAssignedArea(), GetCenterPosition());
+    }
+    else if (enemyType_ == EnemyType::DarkWizardBasic &&
+        Helper::GenerateRandomBool(getThinkChance(0.215)) &&
+        area->HasLineOfSight(GetCenterPosition(), playerAggro->GetCenterPosition())) {
+
+        auto damageEffect = area->GetEntity<DamageEffectEntity>(area->EmplaceEntity<DamageEffectEntity>(
+            DamageEffectType::EnemyBlackFlame, sf::seconds(0.5f)));
+        damageEffect->SetCenterPosition(playerAggro->GetCenterPosition());
+
+        // push player and damage them
+        playerAggro->Attack(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()), DamageType::Magic);
+        playerAggro->MoveWithCollision(sf::Vector2f(Helper::GenerateRandomReal(-8.0f, 8.0f),
+            Helper::GenerateRandomReal(-8.0f, 8.0f)));
+
+        AudioQueue::Get().PlayAt(GameAssets::Get().blastSoundBuffer, GetAssignedArea(), GetCenterPosition());
+    }
+}
+
+
+void BasicEnemy::PrepareTick()
+{
+    hasPreparedMove_ = false;
+
+    auto stats = GetStats();
+    auto area = GetAssignedArea();
+
+    if (!stats || !area || !stats->IsAlive()) {
+        return;
+    }
+
+    // same as MoveWithCollision(), but only noting where we'd end up
+    preparedFromRect_ = GetRectangle();
+    preparedMove_ = GetMoveThisTick();
+    TryMoveWithCollision(preparedMove_, &preparedPos_);
+    hasPreparedMove_ = true;
+}
+
+
+void BasicEnemy::Tick()
+{
+    auto stats = GetStats();
+    auto area = GetAssignedArea();
+
+    bool usePreparedMove = hasPreparedMove_ && preparedFromRect_ == GetRectangle() &&
+        preparedMove_ == GetMoveThisTick();
+    hasPreparedMove_ = false;
+
+    sinceThink_ += GetTickTimeStep();
+
+    if (stats && area) {
+        if (stats->IsAlive()) {
+            if (usePreparedMove) {
+                SetWorldPosition(preparedPos_);
             }
             else {
-                // wander
-                if (nextWanderMoveTime_ <= sf::Time::Zero) {
+                // something moved us after PrepareTick(), so its intents are stale
+                MoveWithCollision(GetMoveThisTick());
+            }
+
+            // keep after the player our last think chose, if they're still alive; if they've died or left our
+            // range since, choose again now rather than chasing them until the next think
+            auto playerAggro = GetAliveAggroPlayer();
+            auto toPlayer = playerAggro ? playerAggro->GetCenterPosition() - GetCenterPosition() : sf::Vector2f();
+
+            if (aggroPlayerId_ != InvalidId && (!playerAggro ||
+                toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y > GetAggroDistance() * GetAggroDistance())) {
+                aggroPlayerId_ = FindAggroPlayer(GetCenterPosition());
+                playerAggro = GetAliveAggroPlayer();
+            }
+
+            if (playerAggro) {
+                // finding our way to them around walls, & across the floor if they're beyond the flow field
+                moveDir_ = area->GetChaseDirection(GetCenterPosition(), playerAggro->GetCenterPosition(), &chasePath_);
+            }
+            else {
+                // wander; our wander timer flags when it's time for a new direction
+                if (wanderDue_) {
                     NewWander();
                 }
-                else {
-                    nextWanderMoveTime_ -= Game::FrameTimeStep;
-                }
             }
 
             // tick anim if moving or if certain enemy type
-            if (moveDir_.x != 0.0f || moveDir_.y != 0.0f ||
+            if (moveDir_ != WorldVector() ||
                 enemyType_ == EnemyType::MagicFlameBasic ||
                 enemyType_ == EnemyType::GhostBasic) {
                 anim_.Tick();
             }
 
             // damage players touching us
-            auto touchingPlayers = area->GetAllWorldEntsInRectangle<PlayerEntity>(GetRectangle());
-
-            for (auto pid : touchingPlayers) {
-                auto player = area->GetEntity<PlayerEntity>(pid);
-                assert(player);
-
+            area->ForEachTouching<PlayerEntity>(*this, [&](PlayerEntity* player) {
                 if (player->GetStats() && player->GetStats()->IsAlive() && !player->HasInvincibility()) {
                     switch (enemyType_) {
                     default:
@@ -1177,20 +1328,20 @@ void BasicEnemy::Tick()
                         player->Attack(Helper::GenerateRandomInt<u32>(0, stats->GetMagicAttack()), DamageType::Magic);
                         break;
                     }
-                    player->MoveWithCollision(moveDir_ * 5.0f); // push player
+                    player->MoveWithCollision(ScaleWorldVector(moveDir_, 5.0f)); // push player
                 }
-            }
+            });
         }
         else if (!droppedItems_) {
             // dead - drop if we havent already
-            GameAssets::Get().deathSound.play();
+            AudioQueue::Get().PlayAt(GameAssets::Get().deathSoundBuffer, GetAssignedArea(), GetCenterPosition());
             HandleDropItems();
         }
     }
 }
 
 
-void BasicEnemy::Render(sf::RenderTarget& target)
+void BasicEnemy::Render(CountingRenderTarget& target)
 {
     auto stats = GetStats();
 
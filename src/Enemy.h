@@ -3,8 +3,12 @@
 #include "Entity.h"
 
 #include <memory>
+#include <vector>
 
 #include "Animation.h"
+#include "NavGraph.h"
+
+class PlayerEntity;
 
 /**
 * Type of enemy
@@ -34,7 +38,7 @@ public:
 
     virtual u32 Damage(u32 damageAmount, DamageType type) override;
 
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     virtual EnemyType GetEnemyType() const = 0;
 };
@@ -54,16 +58,17 @@ enum class DungeonGuardianForm
 */
 class DungeonGuardian : public Enemy
 {
-    std::unique_ptr<AliveStats> stats_;
+    AliveStats stats_;
 
     DungeonGuardianForm form_;
     int formActionsLeft_;
     sf::Time actionTimeLeft_;
-    sf::Time formSoundTimeLeft_;
+    u32 formSoundTimerTag_;
     bool firedThisAction_;
     bool handleDeathAnim_;
 
     sf::Vector2f moveDir_;
+    ChasePath chasePath_;
 
     Animation animMagicForm_;
     Animation animSmokeForm_;
@@ -82,24 +87,39 @@ class DungeonGuardian : public Enemy
     virtual void ResetAnimations();
     virtual void TickAnimations();
 
+protected:
+    virtual void OnAssignedToArea() override;
+    virtual void OnTimer(u32 tag) override;
+
 public:
     DungeonGuardian();
     virtual ~DungeonGuardian();
 
     void PlayerKilled();
 
+    /**
+    * Fires the ring of smoke projectiles used by the smoke form.
+    */
+    static void FireSmokeVolley(WorldArea& area, const sf::Vector2f& center, u32 minDamage, u32 maxDamage);
+
+    /**
+    * Fires the burst of orbs played when the boss dies.
+    */
+    static void FireDeathOrbBurst(WorldArea& area, const sf::Vector2f& center);
+
     virtual void ResetStats(float difficultyMul);
     void ResetStats();
 
+    virtual void PrepareTick() override;
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     inline DungeonGuardianForm GetCurrentForm() const { return form_; }
 
     inline virtual EnemyType GetEnemyType() const override { return EnemyType::DungeonGuardian; }
 
     inline virtual std::string GetUnitName() const override { return "Dungeon Guardian"; }
-    inline virtual std::string GetName() const override { return "DungeonGuardian"; }
+    inline virtual const char* GetName() const override { return "DungeonGuardian"; }
 };
 
 /**
@@ -110,18 +130,41 @@ class BasicEnemy : public Enemy
     EnemyType enemyType_;
 
     Animation anim_;
-    std::unique_ptr<AliveStats> stats_;
+    AliveStats stats_;
 
-    sf::Time nextWanderMoveTime_;
-    sf::Vector2f moveDir_;
+    bool wanderDue_;
+    WorldVector moveDir_;
+    ChasePath chasePath_;
+
+    // the last Think()'s choice of player to chase, & the time since it was made
+    EntityId aggroPlayerId_;
+    sf::Time sinceThink_;
 
     bool droppedItems_;
 
+    // intents from PrepareTick(); Tick() redoes them if we've been moved since
+    bool hasPreparedMove_;
+    sf::FloatRect preparedFromRect_;
+    WorldVector preparedMove_;
+    WorldPosition preparedPos_;
+
+    std::vector<std::pair<EntityId, float>> aggroScratch_;
+
     void SetupAnimations();
     void NewWander();
 
+    WorldVector GetMoveThisTick() const;
+    EntityId FindAggroPlayer(const sf::Vector2f& center);
+    PlayerEntity* GetAliveAggroPlayer() const;
+
     void HandleDropItems();
 
+protected:
+    virtual void OnAssignedToArea() override;
+    inline virtual void OnTimer(u32 tag) override { wanderDue_ = true; }
+
+    virtual bool GetSimLodInfo(sf::Vector2f& outPos, float& outFullRateDistance) const override;
+
 public:
     BasicEnemy(EnemyType enemyType);
     virtual ~BasicEnemy();
@@ -129,8 +172,10 @@ public:
     virtual void ResetStats(float difficultyMul);
     void ResetStats();
 
+    virtual void Think() override;
+    virtual void PrepareTick() override;
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     virtual float GetAggroDistance() const;
 
@@ -141,5 +186,5 @@ public:
 
     virtual std::string GetUnitName() const override;
 
-    inline virtual std::string GetName() const override { return "BasicEnemy"; }
+    inline virtual const char* GetName() const override { return "BasicEnemy"; }
 };
\ No newline at end of file
@@ -11,7 +11,16 @@
 Entity::Entity() :
 assignedId_(Entity::InvalidId),
 assignedArea_(nullptr),
-markedForDeletion_(false)
+markedForDeletion_(false),
+dormant_(false),
+inActiveSet_(false),
+tickTimeStep_(Game::FrameTimeStep),
+lastTickedAt_(0),
+skippedThisTick_(false),
+thinkEnrolled_(false),
+lastThoughtAt_(0),
+typeBucket_(0),
+typeBucketIndex_(0)
 {
 }
 
@@ -21,9 +30,62 @@ Entity::~Entity()
 }
 
 
+void Entity::SetDormant(bool dormant)
+{
+    dormant_ = dormant;
+
+    // the area drops dormant ents from its active set on its next tick
+    if (!dormant_ && assignedArea_) {
+        assignedArea_->ActivateEntity(*this);
+    }
+}
+
+
+void Entity::StartTimer(u32 tag, const sf::Time& delay)
+{
+    if (assignedArea_) {
+        assignedArea_->ScheduleTimer(assignedId_, tag, delay);
+    }
+}
+
+
+void Entity::EnrollThinker()
+{
+    if (assignedArea_) {
+        assignedArea_->EnrollThinker(*this);
+    }
+}
+
+
+void Entity::WakeAfter(const sf::Time& delay)
+{
+    StartTimer(WakeTimerTag, delay);
+}
+
+
+void Entity::MarkForDeletion()
+{
+    if (!markedForDeletion_) {
+        LOG_DEBUG("Marked for delete ent {} (ent id {})", GetName(), assignedId_);
+        markedForDeletion_ = true;
+
+        if (assignedArea_) {
+            assignedArea_->pendingDeletions_.emplace_back(assignedId_);
+        }
+    }
+}
+
+
 WorldEntity::WorldEntity() :
-Entity()
+Entity(),
+collisionLayer_(CollisionLayer::None),
+contactsBegin_(0),
+contactsCount_(0),
+contactsPhase_(0)
 {
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+    fixedPos_ = FixedVector2::FromFixed(Fixed::FromInt(0), Fixed::FromInt(0));
+#endif
 }
 
 
@@ -32,16 +94,64 @@ WorldEntity::~WorldEntity()
 }
 
 
+bool WorldEntity::TryMoveWithCollision(const sf::Vector2f& d, WorldPosition* outPos) const
+{
+    auto area = GetAssignedArea();
+
+    if (!area) {
+        *outPos = GetWorldPosition();
+        return true;
+    }
+
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+    // d is only quantised here, so from this point on the move is exact
+    return TryMoveWithCollision(FixedVector2::FromFloat(d), outPos);
+#else
+    return area->TryCollisionRectMove(GetRectangle(), d, outPos);
+#endif
+}
+
+
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+bool WorldEntity::TryMoveWithCollision(const WorldVector& d, WorldPosition* outPos) const
+{
+    auto area = GetAssignedArea();
+
+    if (!area) {
+        *outPos = GetWorldPosition();
+        return true;
+    }
+
+    auto rect = FixedRect::FromFixed(fixedPos_, FixedVector2::FromFloat(GetSize()));
+    return area->TryCollisionRectMoveFixed(rect, d, outPos);
+}
+
+
+bool WorldEntity::MoveWithCollision(const WorldVector& d)
+{
+    bool noCollision = true;
+
+    if (GetAssignedArea()) {
+        WorldPosition newPos;
+        noCollision = TryMoveWithCollision(d, &newPos);
+
+        SetWorldPosition(newPos);
+    }
+
+    return noCollision;
+}
+#endif
+
+
 bool WorldEntity::MoveWithCollision(const sf::Vector2f& d)
 {
     bool noCollision = true;
-    auto area = GetAssignedArea();
 
-    if (area) {
-        sf::Vector2f newPos;
-        noCollision = area->TryCollisionRectMove(GetRectangle(), d, &newPos);
+    if (GetAssignedArea()) {
+        WorldPosition newPos;
+        noCollision = TryMoveWithCollision(d, &newPos);
 
-        SetPosition(newPos);
+        SetWorldPosition(newPos);
     }
 
     return noCollision;
@@ -65,7 +175,7 @@ type_(type),
 damage_(damageAmount),
 velo_(velo),
 color_(color),
-timeLeft_(displayTime)
+displayTime_(displayTime)
 {
     SetSize(sf::Vector2f(16.0f, 5.0f));
 }
@@ -83,18 +193,10 @@ void DamageTextEntity::Tick()
     }
 
     SetPosition(GetPosition() + velo_ * Game::FrameTimeStep.asSeconds());
-
-    if (timeLeft_ > sf::Time::Zero) {
-        timeLeft_ -= Game::FrameTimeStep;
-    }
-    else {
-        MarkForDeletion();
-        return;
-    }
 }
 
 
-void DamageTextEntity::Render(sf::RenderTarget& target)
+void DamageTextEntity::Render(CountingRenderTarget& target)
 {
     auto area = GetAssignedArea();
 
@@ -150,7 +252,7 @@ void DamageTextEntity::Render(sf::RenderTarget& target)
 
 DamageEffectEntity::DamageEffectEntity(DamageEffectType type, const sf::Time& duration) :
 effectType_(type),
-timeLeft_(duration)
+duration_(duration)
 {
     SetSize(effectType_ == DamageEffectType::EnemyMagicFlame ? sf::Vector2f(24.0f, 24.0f) : sf::Vector2f(16.0f, 16.0f));
     SetupAnimations();
@@ -226,18 +328,11 @@ void DamageEffectEntity::SetupAnimations()
 
 void DamageEffectEntity::Tick()
 {
-    if (timeLeft_ > sf::Time::Zero) {
-        timeLeft_ -= Game::FrameTimeStep;
-        anim_.Tick();
-    }
-    else {
-        MarkForDeletion();
-        return;
-    }
+    anim_.Tick();
 }
 
 
-void DamageEffectEntity::Render(sf::RenderTarget& target)
+void DamageEffectEntity::Render(CountingRenderTarget& target)
 {
     auto effectSprite = std::make_unique<sf::Sprite>(anim_.GetCurrentFrame());
     effectSprite->setPosition(GetPosition());
@@ -250,22 +345,40 @@ void DamageEffectEntity::Render(sf::RenderTarget& target)
 }
 
 
-AliveStats::AliveStats() :
-maxHealth_(1),
-health_(1),
-maxMana_(1),
-mana_(1),
-meleeAttack_(0),
-magicAttack_(0),
-meleeDefence_(0),
-magicDefence_(0),
-moveSpeed_(45.0f)
+AliveStats::AliveStats(AliveStatsStore& store) :
+store_(&store),
+slot_(store.Allocate())
 {
 }
 
 
 AliveStats::~AliveStats()
 {
+    store_->Release(slot_);
+}
+
+
+void AliveStats::MoveToStore(AliveStatsStore& store)
+{
+    if (&store == store_) {
+        return;
+    }
+
+    auto newSlot = store.Allocate();
+
+    store.maxHealth_[newSlot] = store_->maxHealth_[slot_];
+    store.health_[newSlot] = store_->health_[slot_];
+    store.maxMana_[newSlot] = store_->maxMana_[slot_];
+    store.mana_[newSlot] = store_->mana_[slot_];
+    store.meleeAttack_[newSlot] = store_->meleeAttack_[slot_];
+    store.magicAttack_[newSlot] = store_->magicAttack_[slot_];
+    store.meleeDefence_[newSlot] = store_->meleeDefence_[slot_];
+    store.magicDefence_[newSlot] = store_->magicDefence_[slot_];
+    store.moveSpeed_[newSlot] = store_->moveSpeed_[slot_];
+
+    store_->Release(slot_);
+    store_ = &store;
+    slot_ = newSlot;
 }
 
 
@@ -282,6 +395,8 @@ AliveEntity::~AliveEntity()
 
 u32 AliveEntity::Attack(u32 initialDamage, DamageType source)
 {
+    Wake();
+
     auto stats = GetStats();
 
     if (stats && stats->IsAlive()) {
@@ -320,10 +435,10 @@ u32 AliveEntity::Damage(u32 amount, DamageType source)
     }
 
     if (amount <= 0) {
-        GameAssets::Get().blockSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().blockSoundBuffer, GetAssignedArea(), GetCenterPosition());
     }
     else if (source == DamageType::Other) {
-        GameAssets::Get().armourPenSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().armourPenSoundBuffer, GetAssignedArea(), GetCenterPosition());
     }
 
     return amount;
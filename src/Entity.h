@@ -3,11 +3,15 @@
 #include <string>
 #include <iostream>
 
-#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/System/Time.hpp>
 
 #include "Types.h"
+#include "CountingRenderTarget.h"
 #include "Animation.h"
+#include "AliveStatsStore.h"
+#include "Log.h"
+#include "FixedPoint.h"
+#include "Helper.h"
 
 typedef u64 EntityId;
 
@@ -25,46 +29,213 @@ class Entity
     WorldArea* assignedArea_;
     bool markedForDeletion_;
 
+    bool dormant_;
+    bool inActiveSet_;
+
+    // sim LOD state, set by WorldArea before each tick
+    sf::Time tickTimeStep_;
+    u64 lastTickedAt_;
+    bool skippedThisTick_;
+
+    // think scheduler state, kept by WorldArea
+    bool thinkEnrolled_;
+    u64 lastThoughtAt_;
+
+    // where WorldArea keeps us in its per-type index
+    std::size_t typeBucket_;
+    std::size_t typeBucketIndex_;
+
+protected:
+    /**
+    * Dormant ents aren't ticked until something wakes them
+    * (being used by a player, taking damage or a WakeAfter() timer).
+    */
+    void SetDormant(bool dormant);
+
+    /**
+    * Calls OnTimer(tag) once delay has passed in the assigned area. Timers keep
+    * running while the ent is dormant. Does nothing if not assigned to an area yet
+    * (schedule from OnAssignedToArea() instead).
+    */
+    void StartTimer(u32 tag, const sf::Time& delay);
+
+    inline virtual void OnTimer(u32 tag) { }
+    inline virtual void OnAssignedToArea() { }
+
+    /**
+    * Enrolls the ent in its area's think scheduler, so that Think() gets called every so often.
+    * Does nothing if not assigned to an area yet (enroll from OnAssignedToArea() instead).
+    */
+    void EnrollThinker();
+
+    /**
+    * Ents that can be simulated at a lower rate when far from the player return true & write their
+    * position & the distance from the player within which they must still tick every frame.
+    * Those further away tick less often with a longer GetTickTimeStep(), or not at all.
+    */
+    inline virtual bool GetSimLodInfo(sf::Vector2f& outPos, float& outFullRateDistance) const { return false; }
+
+    /**
+    * Time covered by this tick; Game::FrameTimeStep unless the ent is ticking at a reduced rate.
+    */
+    inline sf::Time GetTickTimeStep() const { return tickTimeStep_; }
+
 public:
     static const EntityId InvalidId = UINT64_MAX;
+    static const u32 WakeTimerTag = UINT32_MAX;
 
     Entity();
     virtual ~Entity();
 
+    /**
+    * Read phase of the tick; runs in parallel with the PrepareTick() of the other ents in the area,
+    * before any of them Tick(). May only read the world (with const queries) & write the ent's own
+    * members, so no spawning, RNG, sounds or touching other ents - leave those to Tick().
+    */
+    inline virtual void PrepareTick() { }
     inline virtual void Tick() { }
-    inline virtual void Render(sf::RenderTarget& target) { }
 
-    inline void MarkForDeletion()
-    {
-        if (!markedForDeletion_) {
-            std::cout << "Marked for delete ent " << GetName() << " (ent id " << assignedId_ << ")\n";
-            markedForDeletion_ = true;
-        }
-    }
+    /**
+    * Decision making (picking targets, rolling attacks .etc) for ents enrolled with EnrollThinker(). Called
+    * by the area's think scheduler every few ticks, as its time budget allows, before the tick's PrepareTick()s.
+    * Tick() should carry on with the last decision made in between.
+    */
+    inline virtual void Think() { }
+    inline virtual void Render(CountingRenderTarget& target) { }
 
+    void MarkForDeletion();
     inline bool IsMarkedForDeletion() const { return markedForDeletion_; }
 
+    inline void Wake() { SetDormant(false); }
+    void WakeAfter(const sf::Time& delay);
+    inline bool IsDormant() const { return dormant_; }
+
     inline EntityId GetAssignedId() const { return assignedId_; }
     inline WorldArea* GetAssignedArea() const { return assignedArea_; }
 
-    virtual std::string GetName() const = 0;
+    virtual const char* GetName() const = 0;
+};
+
+/**
+* Layers of an area's collision phase. The area's layer matrix decides which of them collide.
+*/
+enum class CollisionLayer : u8
+{
+    None,
+    Player,
+    Enemy,
+    Projectile,
+    Pickup
 };
 
 /**
 * Base class for an ent inside of the world with a pos and size.
 */
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+/**
+* Where a WorldEntity is, & the directions & velocities that move it. Fixed point when built with
+* UOLEDUGAME_FIXED_POINT_MOVEMENT so that positions, enemy & projectile velocities & tile collision are
+* integer maths, float otherwise. The float inputs to them (separation, raycasts, player movement .etc) still
+* depend on the compiler & platform.
+*/
+typedef FixedVector2 WorldPosition;
+typedef FixedVector2 WorldVector;
+
+inline sf::Vector2f WorldPositionToFloat(const WorldPosition& pos) { return pos.ToFloat(); }
+inline sf::Vector2f WorldVectorToFloat(const WorldVector& v) { return v.ToFloat(); }
+inline WorldVector WorldVectorFromFloat(const sf::Vector2f& v) { return FixedVector2::FromFloat(v); }
+
+/**
+* Unit vector in the direction of v; v is quantised before it's normalised, so the result doesn't depend on
+* how the float maths is compiled.
+*/
+inline WorldVector GetWorldUnitVector(const sf::Vector2f& v) { return FixedVector2::FromFloat(v).GetUnit(); }
+
+/**
+* v scaled by each of the scales in turn; they're quantised first, so the products are exact.
+*/
+inline WorldVector ScaleWorldVector(const WorldVector& v, float scale) { return v * Fixed::FromFloat(scale); }
+inline WorldVector ScaleWorldVector(const WorldVector& v, float scale, float otherScale)
+{
+    return v * (Fixed::FromFloat(scale) * Fixed::FromFloat(otherScale));
+}
+#else
+typedef sf::Vector2f WorldPosition;
+typedef sf::Vector2f WorldVector;
+
+inline sf::Vector2f WorldPositionToFloat(const WorldPosition& pos) { return pos; }
+inline sf::Vector2f WorldVectorToFloat(const WorldVector& v) { return v; }
+inline WorldVector WorldVectorFromFloat(const sf::Vector2f& v) { return v; }
+
+inline WorldVector GetWorldUnitVector(const sf::Vector2f& v) { return Helper::GetUnitVector(v); }
+
+inline WorldVector ScaleWorldVector(const WorldVector& v, float scale) { return v * scale; }
+inline WorldVector ScaleWorldVector(const WorldVector& v, float scale, float otherScale)
+{
+    return v * scale * otherScale;
+}
+#endif
+
 class WorldEntity : public Entity
 {
+    // WorldArea's collision phase keeps its broadphase state in here
+    friend class WorldArea;
+
     sf::FloatRect rect_;
+    CollisionLayer collisionLayer_;
+
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+    // the real position; rect_'s is only ever converted from this, for rendering & float queries
+    FixedVector2 fixedPos_;
+
+    inline void SetFixedPosition(const FixedVector2& pos)
+    {
+        fixedPos_ = pos;
+        rect_.left = pos.x.ToFloat();
+        rect_.top = pos.y.ToFloat();
+    }
+#endif
+
+    // the rect (padded) that contacts were last found for, & where those contacts are in the area's list
+    sf::FloatRect collisionBounds_;
+    std::size_t contactsBegin_, contactsCount_;
+    u64 contactsPhase_;
+
+protected:
+    /**
+    * Sets the layer the ent collides on. Must be set before the ent is added to an area.
+    */
+    inline void SetCollisionLayer(CollisionLayer layer) { collisionLayer_ = layer; }
 
 public:
     WorldEntity();
     virtual ~WorldEntity();
 
-    inline void SetRectangle(const sf::FloatRect& rect) { rect_ = rect; }
-    inline sf::FloatRect GetRectangle() const { return rect_; }
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+    inline void SetRectangle(const sf::FloatRect& rect)
+    {
+        SetSize(sf::Vector2f(rect.width, rect.height));
+        SetPosition(sf::Vector2f(rect.left, rect.top));
+    }
 
+    inline void SetPosition(const sf::Vector2f& pos) { SetFixedPosition(FixedVector2::FromFloat(pos)); }
+
+    inline void SetWorldPosition(const WorldPosition& pos) { SetFixedPosition(pos); }
+    inline WorldPosition GetWorldPosition() const { return fixedPos_; }
+
+    inline void Move(const sf::Vector2f& d) { SetFixedPosition(fixedPos_ + FixedVector2::FromFloat(d)); }
+    inline void Move(const WorldVector& d) { SetFixedPosition(fixedPos_ + d); }
+#else
+    inline void SetRectangle(const sf::FloatRect& rect) { rect_ = rect; }
     inline void SetPosition(const sf::Vector2f& pos) { rect_.left = pos.x; rect_.top = pos.y; }
+
+    inline void SetWorldPosition(const WorldPosition& pos) { SetPosition(pos); }
+    inline WorldPosition GetWorldPosition() const { return GetPosition(); }
+
+    inline void Move(const sf::Vector2f& d) { rect_.left += d.x; rect_.top += d.y; }
+#endif
+
+    inline sf::FloatRect GetRectangle() const { return rect_; }
     inline sf::Vector2f GetPosition() const { return sf::Vector2f(rect_.left, rect_.top); }
 
     inline void SetSize(const sf::Vector2f& size) { rect_.width = size.x; rect_.height = size.y; }
@@ -73,8 +244,19 @@ public:
     inline void SetCenterPosition(const sf::Vector2f& pos) { SetPosition(pos - GetSize() * 0.5f); }
     inline sf::Vector2f GetCenterPosition() const { return GetPosition() + GetSize() * 0.5f; }
 
-    inline void Move(const sf::Vector2f& d) { rect_.left += d.x; rect_.top += d.y; }
+    /**
+    * Works out where MoveWithCollision(d) would leave the ent, without moving it. Returns false if it would
+    * hit a tile.
+    */
+    bool TryMoveWithCollision(const sf::Vector2f& d, WorldPosition* outPos) const;
     bool MoveWithCollision(const sf::Vector2f& d);
+
+#ifdef UOLEDUGAME_FIXED_POINT_MOVEMENT
+    bool TryMoveWithCollision(const WorldVector& d, WorldPosition* outPos) const;
+    bool MoveWithCollision(const WorldVector& d);
+#endif
+
+    inline CollisionLayer GetCollisionLayer() const { return collisionLayer_; }
 };
 
 /**
@@ -90,55 +272,76 @@ public:
 };
 
 /**
-* Stats of an AliveEnt.
+* Stats of an AliveEnt. A handle to a slot in an AliveStatsStore.
 */
 class AliveStats
 {
-    u32 maxHealth_, health_;
-    u32 maxMana_, mana_;
-    u32 meleeAttack_, magicAttack_;
-    u32 meleeDefence_, magicDefence_;
-    float moveSpeed_;
+    AliveStatsStore* store_;
+    AliveStatsStore::Slot slot_;
 
 public:
-    AliveStats();
-    virtual ~AliveStats();
+    explicit AliveStats(AliveStatsStore& store = AliveStatsStore::GetDetached());
+    ~AliveStats();
+
+    AliveStats(const AliveStats&) = delete;
+    AliveStats& operator=(const AliveStats&) = delete;
+
+    /**
+    * Moves these stats into a slot of store (e.g. that of the area the owner was added to).
+    */
+    void MoveToStore(AliveStatsStore& store);
+
+    /**
+    * Resets the stats back to their defaults.
+    */
+    inline void Reset() { store_->ResetSlot(slot_); }
 
-    inline virtual void SetHealth(u32 health) { health_ = std::min(maxHealth_, health); }
-    inline virtual u32 GetHealth() const { return health_; }
+    inline AliveStatsStore& GetStore() const { return *store_; }
+    inline AliveStatsStore::Slot GetSlot() const { return slot_; }
 
-    inline virtual bool IsAlive() const { return health_ > 0; }
+    inline void SetHealth(u32 health) { store_->health_[slot_] = std::min(GetMaxHealth(), health); }
+    inline u32 GetHealth() const { return store_->health_[slot_]; }
 
-    inline virtual void ApplyDamage(u32 damage) { health_ -= std::min(damage, health_); }
-    inline virtual void ApplyHealing(u32 healAmount)
+    inline bool IsAlive() const { return GetHealth() > 0; }
+
+    inline void ApplyDamage(u32 damage) { store_->health_[slot_] -= std::min(damage, GetHealth()); }
+    inline void ApplyHealing(u32 healAmount)
     {
-        health_ += std::min(healAmount, UINT32_MAX - health_);
-        health_ = std::min(maxHealth_, health_);
+        auto health = GetHealth() + std::min(healAmount, UINT32_MAX - GetHealth());
+        store_->health_[slot_] = std::min(GetMaxHealth(), health);
     }
 
-    inline virtual void SetMaxHealth(u32 maxHealth) { maxHealth_ = maxHealth; health_ = std::min(maxHealth_, health_); }
-    inline virtual u32 GetMaxHealth() const { return maxHealth_; }
+    inline void SetMaxHealth(u32 maxHealth)
+    {
+        store_->maxHealth_[slot_] = maxHealth;
+        store_->health_[slot_] = std::min(maxHealth, GetHealth());
+    }
+    inline u32 GetMaxHealth() const { return store_->maxHealth_[slot_]; }
 
-    inline virtual void SetMana(u32 mana) { mana_ = std::min(maxMana_, mana); }
-    inline virtual u32 GetMana() const { return mana_; }
+    inline void SetMana(u32 mana) { store_->mana_[slot_] = std::min(GetMaxMana(), mana); }
+    inline u32 GetMana() const { return store_->mana_[slot_]; }
 
-    inline virtual void SetMaxMana(u32 maxMana) { maxMana_ = maxMana; mana_ = std::min(maxMana_, mana_); }
-    inline virtual u32 GetMaxMana() const { return maxMana_; }
+    inline void SetMaxMana(u32 maxMana)
+    {
+        store_->maxMana_[slot_] = maxMana;
+        store_->mana_[slot_] = std::min(maxMana, GetMana());
+    }
+    inline u32 GetMaxMana() const { return store_->maxMana_[slot_]; }
 
-    inline virtual void SetMeleeAttack(u32 attack) { meleeAttack_ = attack; }
-    inline virtual u32 GetMeleeAttack() const { return meleeAttack_; }
+    inline void SetMeleeAttack(u32 attack) { store_->meleeAttack_[slot_] = attack; }
+    inline u32 GetMeleeAttack() const { return store_->meleeAttack_[slot_]; }
 
-    inline virtual void SetMagicAttack(u32 attack) { magicAttack_ = attack; }
-    inline virtual u32 GetMagicAttack() const { return magicAttack_; }
+    inline void SetMagicAttack(u32 attack) { store_->magicAttack_[slot_] = attack; }
+    inline u32 GetMagicAttack() const { return store_->magicAttack_[slot_]; }
 
-    inline virtual void SetMeleeDefence(u32 defence) { meleeDefence_ = defence; }
-    inline virtual u32 GetMeleeDefence() const { return meleeDefence_; }
+    inline void SetMeleeDefence(u32 defence) { store_->meleeDefence_[slot_] = defence; }
+    inline u32 GetMeleeDefence() const { return store_->meleeDefence_[slot_]; }
 
-    inline virtual void SetMagicDefence(u32 defence) { magicDefence_ = defence; }
-    inline virtual u32 GetMagicDefence() const { return magicDefence_; }
+    inline void SetMagicDefence(u32 defence) { store_->magicDefence_[slot_] = defence; }
+    inline u32 GetMagicDefence() const { return store_->magicDefence_[slot_]; }
 
-    inline virtual void SetMoveSpeed(float speed) { moveSpeed_ = speed; }
-    inline virtual float GetMoveSpeed() const { return moveSpeed_; }
+    inline void SetMoveSpeed(float speed) { store_->moveSpeed_[slot_] = speed; }
+    inline float GetMoveSpeed() const { return store_->moveSpeed_[slot_]; }
 };
 
 /**
@@ -160,7 +363,11 @@ class DamageTextEntity : public WorldEntity
     u32 damage_;
     sf::Color color_;
     sf::Vector2f velo_;
-    sf::Time timeLeft_;
+    sf::Time displayTime_;
+
+protected:
+    inline virtual void OnAssignedToArea() override { StartTimer(0, displayTime_); }
+    inline virtual void OnTimer(u32 tag) override { MarkForDeletion(); }
 
 public:
     DamageTextEntity(DamageType type, u32 damage, const sf::Color& color = sf::Color(255, 255, 255),
@@ -168,14 +375,14 @@ public:
     virtual ~DamageTextEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     inline DamageType GetDamageType() const { return type_; }
     inline u32 GetDamageAmount() const { return damage_; }
     inline sf::Vector2f GetVelocity() const { return velo_; }
     inline sf::Color GetTextColor() const { return color_; }
 
-    inline virtual std::string GetName() const override { return "DamageTextEntity"; }
+    inline virtual const char* GetName() const override { return "DamageTextEntity"; }
 };
 
 /**
@@ -200,21 +407,25 @@ class DamageEffectEntity : public WorldEntity
 {
     DamageEffectType effectType_;
     Animation anim_;
-    sf::Time timeLeft_;
+    sf::Time duration_;
 
     void SetupAnimations();
 
+protected:
+    inline virtual void OnAssignedToArea() override { StartTimer(0, duration_); }
+    inline virtual void OnTimer(u32 tag) override { MarkForDeletion(); }
+
 public:
     DamageEffectEntity(DamageEffectType type, const sf::Time& duration);
     virtual ~DamageEffectEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     inline DamageEffectType GetEffectType() const { return effectType_; }
-    inline sf::Time GetTimeLeft() const { return timeLeft_; }
+    inline sf::Time GetDuration() const { return duration_; }
 
-    inline virtual std::string GetName() const override { return "DamageEffectEntity"; }
+    inline virtual const char* GetName() const override { return "DamageEffectEntity"; }
 };
 
 /**
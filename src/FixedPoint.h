@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "Types.h"
+
+/**
+* Fixed point number with 16 fractional bits, stored in 64 bits so that positions anywhere in an area (up to
+* +-2^47) fit. All of its arithmetic is done on integers, so it gives the same results whatever the
+* compiler, its flags (fast-math, FMA contraction .etc) or the platform.
+*/
+struct Fixed
+{
+    static const int FractionBits = 16;
+    static const i64 One = static_cast<i64>(1) << FractionBits;
+
+    i64 raw;
+
+    static inline Fixed FromRaw(i64 raw)
+    {
+        Fixed result;
+        result.raw = raw;
+        return result;
+    }
+
+    static inline Fixed FromInt(i64 value) { return FromRaw(value * One); }
+
+    /**
+    * Rounds value to the nearest 1/65536th. Scaling by a power of 2 is exact, so this is deterministic.
+    */
+    static inline Fixed FromFloat(float value) { return FromRaw(static_cast<i64>(std::llround(value * One))); }
+    inline float ToFloat() const { return static_cast<float>(raw) / One; }
+
+    /**
+    * Integer division rounding towards negative & positive infinity respectively.
+    */
+    static inline i64 FloorDiv(i64 a, i64 b) { return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0); }
+    static inline i64 CeilDiv(i64 a, i64 b) { return a / b + ((a % b != 0 && (a < 0) == (b < 0)) ? 1 : 0); }
+
+    inline Fixed operator-() const { return FromRaw(-raw); }
+
+    inline Fixed operator+(Fixed other) const { return FromRaw(raw + other.raw); }
+    inline Fixed operator-(Fixed other) const { return FromRaw(raw - other.raw); }
+
+    // products & quotients are truncated towards zero. they're worked out on 128-bit magnitudes, so they're
+    // exact for any operands; results that don't fit are saturated to the largest Fixed of their sign
+    inline Fixed operator*(Fixed other) const
+    {
+        const auto a = Magnitude(raw), b = Magnitude(other.raw);
+
+        // a * b as hi * 2^64 + lo, from its four 32-bit partial products
+        const u64 aLo = a & 0xffffffffu, aHi = a >> 32;
+        const u64 bLo = b & 0xffffffffu, bHi = b >> 32;
+        const u64 lolo = aLo * bLo, lohi = aLo * bHi, hilo = aHi * bLo, hihi = aHi * bHi;
+        const u64 mid = (lolo >> 32) + (lohi & 0xffffffffu) + (hilo & 0xffffffffu);
+        const u64 lo = (lolo & 0xffffffffu) | (mid << 32);
+        const u64 hi = hihi + (lohi >> 32) + (hilo >> 32) + (mid >> 32);
+
+        if ((hi >> FractionBits) != 0) {
+            return Saturated((raw < 0) != (other.raw < 0));
+        }
+
+        return FromMagnitude((hi << (64 - FractionBits)) | (lo >> FractionBits), (raw < 0) != (other.raw < 0));
+    }
+
+    inline Fixed operator/(Fixed other) const
+    {
+        const auto a = Magnitude(raw), b = Magnitude(other.raw);
+
+        // whole part first, then the fraction bits one at a time by long division; the remainder stays under
+        // b (at most 2^63), so doubling it never overflows
+        const u64 whole = a / b;
+        u64 remainder = a % b;
+
+        if ((whole >> (63 - FractionBits)) != 0) {
+            return Saturated((raw < 0) != (other.raw < 0));
+        }
+
+        u64 quotient = whole;
+
+        for (int i = 0; i < FractionBits; ++i) {
+            remainder <<= 1;
+            quotient <<= 1;
+
+            if (remainder >= b) {
+                remainder -= b;
+                quotient |= 1;
+            }
+        }
+
+        return FromMagnitude(quotient, (raw < 0) != (other.raw < 0));
+    }
+
+    inline Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+    inline Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+
+    inline bool operator==(Fixed other) const { return raw == other.raw; }
+    inline bool operator!=(Fixed other) const { return raw != other.raw; }
+    inline bool operator<(Fixed other) const { return raw < other.raw; }
+    inline bool operator<=(Fixed other) const { return raw <= other.raw; }
+    inline bool operator>(Fixed other) const { return raw > other.raw; }
+    inline bool operator>=(Fixed other) const { return raw >= other.raw; }
+
+private:
+    static inline u64 Magnitude(i64 value)
+    {
+        return value < 0 ? static_cast<u64>(0) - static_cast<u64>(value) : static_cast<u64>(value);
+    }
+
+    static inline Fixed Saturated(bool negative)
+    {
+        return FromRaw(negative ? std::numeric_limits<i64>::min() : std::numeric_limits<i64>::max());
+    }
+
+    static inline Fixed FromMagnitude(u64 magnitude, bool negative)
+    {
+        if (magnitude > static_cast<u64>(std::numeric_limits<i64>::max())) {
+            return Saturated(negative);
+        }
+
+        return FromRaw(negative ? -static_cast<i64>(magnitude) : static_cast<i64>(magnitude));
+    }
+};
+
+/**
+* 2D vector of Fixeds.
+*/
+struct FixedVector2
+{
+    Fixed x, y;
+
+    static inline FixedVector2 FromFixed(Fixed x, Fixed y)
+    {
+        FixedVector2 result;
+        result.x = x;
+        result.y = y;
+        return result;
+    }
+
+    static inline FixedVector2 FromFloat(const sf::Vector2f& v)
+    {
+        return FromFixed(Fixed::FromFloat(v.x), Fixed::FromFloat(v.y));
+    }
+    inline sf::Vector2f ToFloat() const { return sf::Vector2f(x.ToFloat(), y.ToFloat()); }
+
+    inline FixedVector2 operator+(const FixedVector2& other) const { return FromFixed(x + other.x, y + other.y); }
+    inline FixedVector2 operator-(const FixedVector2& other) const { return FromFixed(x - other.x, y - other.y); }
+    inline FixedVector2 operator*(Fixed scale) const { return FromFixed(x * scale, y * scale); }
+
+    /**
+    * Same direction, but of length 1 (to within a few 1/65536ths); (1, 0) for the zero vector, like
+    * Helper::GetUnitVector().
+    */
+    inline FixedVector2 GetUnit() const
+    {
+        auto unitX = x.raw, unitY = y.raw;
+
+        if (unitX == 0 && unitY == 0) {
+            return FromFixed(Fixed::FromInt(1), Fixed::FromInt(0));
+        }
+
+        // bring the larger component into [2^15, 2^30) first; big enough to keep the precision, small
+        // enough that the squares can't overflow
+        auto larger = [&]() { return std::max(unitX < 0 ? -unitX : unitX, unitY < 0 ? -unitY : unitY); };
+
+        while (larger() >= (static_cast<i64>(1) << 30)) {
+            unitX /= 2;
+            unitY /= 2;
+        }
+        while (larger() < (static_cast<i64>(1) << 15)) {
+            unitX *= 2;
+            unitY *= 2;
+        }
+
+        auto length = static_cast<i64>(SquareRoot(static_cast<u64>(unitX * unitX) + static_cast<u64>(unitY * unitY)));
+        return FromFixed(Fixed::FromRaw(unitX * Fixed::One / length), Fixed::FromRaw(unitY * Fixed::One / length));
+    }
+
+    /**
+    * Integer square root, rounded down.
+    */
+    static inline u64 SquareRoot(u64 value)
+    {
+        u64 result = 0;
+        u64 bit = static_cast<u64>(1) << 62;
+
+        while (bit > value) {
+            bit >>= 2;
+        }
+
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else {
+                result >>= 1;
+            }
+
+            bit >>= 2;
+        }
+
+        return result;
+    }
+
+    inline FixedVector2& operator+=(const FixedVector2& other) { x += other.x; y += other.y; return *this; }
+
+    inline bool operator==(const FixedVector2& other) const { return x == other.x && y == other.y; }
+    inline bool operator!=(const FixedVector2& other) const { return !(*this == other); }
+};
+
+/**
+* Rectangle of Fixeds.
+*/
+struct FixedRect
+{
+    Fixed left, top, width, height;
+
+    static inline FixedRect FromFixed(const FixedVector2& pos, const FixedVector2& size)
+    {
+        FixedRect result;
+        result.left = pos.x;
+        result.top = pos.y;
+        result.width = size.x;
+        result.height = size.y;
+        return result;
+    }
+
+    static inline FixedRect FromFloat(const sf::FloatRect& rect)
+    {
+        return FromFixed(FixedVector2::FromFloat(sf::Vector2f(rect.left, rect.top)),
+            FixedVector2::FromFloat(sf::Vector2f(rect.width, rect.height)));
+    }
+    inline sf::FloatRect ToFloat() const
+    {
+        return sf::FloatRect(left.ToFloat(), top.ToFloat(), width.ToFloat(), height.ToFloat());
+    }
+};
@@ -7,6 +7,8 @@
 #include <SFML/Graphics/RectangleShape.hpp>
 
 #include "Helper.h"
+#include "Log.h"
+#include "Profiler.h"
 #include "GameFilesystemGen.h"
 #include "Player.h"
 #include "PlayerUsable.h"
@@ -77,36 +79,6 @@ bool GameAssets::LoadAssets()
     LOAD_FROM_FILE(bossDeadSoundBuffer, "assets/Sounds/BossDeadSound.wav");
     LOAD_FROM_FILE(bossActionSoundBuffer, "assets/Sounds/BossActionSound.wav");
 
-    // sounds init
-    selectSound.setBuffer(selectSoundBuffer);
-    drinkSound.setBuffer(drinkSoundBuffer);
-    blastSound.setBuffer(blastSoundBuffer);
-    waveSound.setBuffer(waveSoundBuffer);
-    drainSound.setBuffer(drainSoundBuffer);
-    zeroBlastSound.setBuffer(zeroBlastSoundBuffer);
-    pickupSound.setBuffer(pickupSoundBuffer);
-    artefactPickupSound.setBuffer(pickup2SoundBuffer);
-    attackSound.setBuffer(attackSoundBuffer);
-    hitSound.setBuffer(hitSoundBuffer);
-    specSound.setBuffer(specSoundBuffer);
-    lowHealthSound.setBuffer(lowHealthSoundBuffer);
-    deathSound.setBuffer(deathSoundBuffer);
-    playerHurtSound.setBuffer(playerHurtSoundBuffer);
-    playerDeathSound.setBuffer(playerDeathSoundBuffer);
-    successSound.setBuffer(successSoundBuffer);
-    failureSound.setBuffer(failureSoundBuffer);
-    openChestSound.setBuffer(openChestSoundBuffer);
-    blockSound.setBuffer(blockSoundBuffer);
-    armourPenSound.setBuffer(armourPenSoundBuffer);
-    invincibilitySound.setBuffer(invincibilitySoundBuffer);
-    magicFireSound.setBuffer(magicFireSoundBuffer);
-    smokeSound.setBuffer(smokeSoundBuffer);
-    bossSwordSound.setBuffer(bossSwordSoundBuffer);
-    bossSpawnSound.setBuffer(bossSpawnSoundBuffer);
-    bossDyingSound.setBuffer(bossDyingSoundBuffer);
-    bossDeadSound.setBuffer(bossDeadSoundBuffer);
-    bossActionSound.setBuffer(bossActionSoundBuffer);
-
     return true;
 }
 
@@ -120,7 +92,10 @@ playerId_(Entity::InvalidId),
 state_(GameState::Menu1),
 mapMode_(false),
 isPaused_(false),
-scheduledNewGame_(false)
+scheduledNewGame_(false),
+thinkBudgetMicroseconds_(0),
+reportDraws_(false),
+reportedRenderFrameCount_(0)
 {
     // add these so that they can be shuffled when the display question UI is invoked.
     displayedQuestionShuffledChoices_.emplace_back(GameQuestionAnswerChoice::CorrectChoice);
@@ -255,17 +230,7 @@ bool Game::ChangeLevel(const std::string& fsNodePath)
         // if our current node is the parent of our old node, spawn at
         // the down stairs that navigate to our old node's area
 
-        auto downstairEnts = currentArea->GetAllEntitiesOfType<DownStairEntity>();
-        DownStairEntity* startDownstairEnt = nullptr;
-
-        for (auto entId : downstairEnts) {
-            auto ent = currentArea->GetEntity<DownStairEntity>(entId);
-
-            if (ent && ent->GetDestinationFsNodeName() == oldFsNode->GetName()) {
-                startDownstairEnt = ent;
-                break;
-            }
-        }
+        auto startDownstairEnt = currentArea->GetFsNodeEntity<DownStairEntity>(oldFsNode);
 
         if (!startDownstairEnt) {
             std::cerr << "WARN - could not find corrisponding DownStairEntity to spawn player at!\n";
@@ -316,7 +281,7 @@ bool Game::ChangeLevel(const std::string& fsNodePath)
     director_.PlayerChangedArea(currentArea);
     mapMode_ = false;
 
-    GameAssets::Get().openChestSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().openChestSoundBuffer);
     AddMessage("You are on floor " + GameFilesystem::GetNodePathString(*currentFsNode),
         sf::Color(255, 255, 0));
     return true;
@@ -341,21 +306,12 @@ bool Game::TeleportPlayerToObjective()
                 return false;
             }
 
-            auto chestIds = GetWorldArea()->GetAllEntitiesOfType<ChestEntity>();
+            auto chestEnt = GetWorldArea()->GetFsNodeEntity<ChestEntity>(director_.GetCurrentArtefactNode());
 
-            for (auto id : chestIds) {
-                auto chestEnt = GetWorldArea()->GetEntity<ChestEntity>(id);
-                assert(chestEnt);
-
-                if (director_.GetCurrentArtefactNode()->GetName() == chestEnt->GetChestFsNodeName()) {
-                    // tp player to artefact chest
-                    if (GetPlayerEntity()) {
-                        std::cout << "Teleported player to artefact chest.\n";
-                        GetPlayerEntity()->SetCenterPosition(chestEnt->GetCenterPosition());
-                    }
-
-                    break;
-                }
+            if (chestEnt && GetPlayerEntity()) {
+                // tp player to artefact chest
+                std::cout << "Teleported player to artefact chest.\n";
+                GetPlayerEntity()->SetCenterPosition(chestEnt->GetCenterPosition());
             }
         }
         return true;
@@ -375,6 +331,42 @@ bool Game::TeleportPlayerToObjective()
 }
 
 
+bool Game::ShowPathToObjective()
+{
+    auto area = GetWorldArea();
+    auto player = GetPlayerEntity();
+    auto targetNode = director_.GetCurrentArtefactNode();
+
+    if (!area || !player || !targetNode) {
+        return false;
+    }
+
+    // the artefact's chest if it's on this floor, else the stairs down towards it
+    while (targetNode->GetParent() && targetNode->GetParent() != area->GetRelatedNode()) {
+        targetNode = targetNode->GetParent();
+    }
+
+    auto targetEnt = area->GetFsNodeEntity<WorldEntity>(targetNode);
+    std::vector<sf::Vector2f> waypoints;
+
+    if (!targetEnt || !area->FindPath(player->GetCenterPosition(), targetEnt->GetCenterPosition(), &waypoints)) {
+        LOG_INFO("No path to the objective from here.");
+        return false;
+    }
+
+    for (auto& waypoint : waypoints) {
+        auto waypointDbg = std::make_unique<sf::RectangleShape>(sf::Vector2f(4.0f, 4.0f));
+        waypointDbg->setPosition(waypoint - sf::Vector2f(2.0f, 2.0f));
+        waypointDbg->setFillColor(sf::Color(100, 255, 100));
+
+        area->AddDebugRenderable(sf::seconds(5.0f), std::move(waypointDbg));
+    }
+
+    LOG_INFO("Path to the objective is {} tile(s) long.", waypoints.size());
+    return true;
+}
+
+
 bool Game::NewGame()
 {
     scheduledLevelChangeFsNodePath_ = std::string();
@@ -416,7 +408,7 @@ bool Game::NewGame()
 }
 
 
-void Game::UpdateCamera(sf::RenderTarget& target)
+void Game::UpdateCamera(CountingRenderTarget& target)
 {
     auto area = GetWorldArea();
 
@@ -498,7 +490,7 @@ void Game::HandleDisplayedQuestionInput()
 
     // play changed input sound
     if (changedInput) {
-        GameAssets::Get().selectSound.play();
+        AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer, SoundPriority::High);
     }
 
     // ENTER to select
@@ -506,12 +498,12 @@ void Game::HandleDisplayedQuestionInput()
         auto selectedChoice = displayedQuestionShuffledChoices_[displayedQuestionSelectedChoice_];
         
         if (selectedChoice == GameQuestionAnswerChoice::CorrectChoice) {
-            GameAssets::Get().successSound.play();
+            AudioQueue::Get().Play(GameAssets::Get().successSoundBuffer, SoundPriority::High);
 
             director_.AnswerQuestionResult(GameQuestionAnswerResult::Correct, GetWorldArea());
         }
         else {
-            GameAssets::Get().failureSound.play();
+            AudioQueue::Get().Play(GameAssets::Get().failureSoundBuffer, SoundPriority::High);
 
             director_.AnswerQuestionResult(GameQuestionAnswerResult::Wrong, GetWorldArea());
 
@@ -544,8 +536,8 @@ void Game::HandleRespawnSacrificeInput()
 
     if (Game::IsKeyPressedFromEvent(sf::Keyboard::Return)) {
         AddMessage("You have been revived!", sf::Color(0, 255, 0));
-        GameAssets::Get().selectSound.play();
-        GameAssets::Get().invincibilitySound.play();
+        AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer, SoundPriority::High);
+        AudioQueue::Get().Play(GameAssets::Get().invincibilitySoundBuffer, SoundPriority::High);
 
         auto pInv = player->GetInventory();
 
@@ -645,7 +637,7 @@ void Game::HandlePlayerLowHealthBeep()
     // beep if low health and not dead if timer is <= 0
     if (IsPlayerLowHealth() && player->GetStats()->IsAlive()) {
         if (lowHealthNextBeepTimeLeft_ <= sf::Time::Zero) {
-            GameAssets::Get().lowHealthSound.play();
+            AudioQueue::Get().Play(GameAssets::Get().lowHealthSoundBuffer, SoundPriority::High);
 
             lowHealthNextBeepTimeLeft_ = sf::seconds(1.0f);
         }
@@ -659,6 +651,8 @@ void Game::HandlePlayerLowHealthBeep()
 
 void Game::Tick()
 {
+    PROFILE_ZONE("Game::Tick");
+
     // check if we have a scheduled new game
     if (scheduledNewGame_) {
         if (!NewGame()) {
@@ -682,6 +676,16 @@ void Game::Tick()
                 TeleportPlayerToObjective();
             }
 
+            if (Game::IsKeyPressedFromEvent(sf::Keyboard::P)) {
+                // show the way to the objective
+                ShowPathToObjective();
+            }
+
+            if (Game::IsKeyPressedFromEvent(sf::Keyboard::F12)) {
+                // dump the zones allocating the most so far
+                Profiler::Get().PrintTopAllocatingZones();
+            }
+
             if (player) {
                 // give invincibility if debug mode
                 player->SetInvincibility(sf::seconds(2.0f));
@@ -751,6 +755,23 @@ void Game::Tick()
                     director_.EndGame();
                 }
 
+                // stress scene spawning
+                if (GetWorldArea()) {
+                    if (Game::IsKeyPressedFromEvent(sf::Keyboard::Numpad1)) {
+                        stressScene_.SpawnEnemies(*GetWorldArea(), 100, player->GetCenterPosition());
+                    }
+                    else if (Game::IsKeyPressedFromEvent(sf::Keyboard::Numpad2)) {
+                        stressScene_.AddProjectileStreams(*GetWorldArea(), 10, player->GetCenterPosition());
+                    }
+                    else if (Game::IsKeyPressedFromEvent(sf::Keyboard::Numpad3)) {
+                        stressScene_.SetGuardianVolleys(*GetWorldArea(), !stressScene_.IsFiringGuardianVolleys());
+                    }
+                    else if (Game::IsKeyPressedFromEvent(sf::Keyboard::Numpad0)) {
+                        stressScene_.PrintReport();
+                        stressScene_.Clear(GetWorldArea());
+                    }
+                }
+
                 if (weapon) {
                     weapon->SetDifficultyMultiplier(director_.GetCurrentDifficultyMultiplier());
                     player->PickupItem(weapon.get());
@@ -770,14 +791,14 @@ void Game::Tick()
             if (!displayedQuestion_ && Game::IsKeyPressedFromEvent(sf::Keyboard::Escape)) {
                 // toggle pausing
                 isPaused_ = !isPaused_;
-                GameAssets::Get().selectSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer, SoundPriority::High);
             }
 
             // do not tick certain input if paused
             if (!isPaused_) {
                 // handle map mode toggle
                 if (Game::IsKeyPressedFromEvent(sf::Keyboard::M) || Game::IsKeyPressedFromEvent(sf::Keyboard::Tab)) {
-                    GameAssets::Get().selectSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer, SoundPriority::High);
                     mapMode_ = !mapMode_;
                 }
 
@@ -797,7 +818,7 @@ void Game::Tick()
                 if (director_.GetCurrentObjectiveType() == GameObjectiveType::End &&
                     Game::IsKeyPressedFromEvent(sf::Keyboard::Return)) {
                     // return to menu1
-                    GameAssets::Get().successSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().successSoundBuffer, SoundPriority::High);
                     state_ = GameState::Menu1;
                 }
                 else if (player && player->GetStats() && !player->GetStats()->IsAlive()) {
@@ -819,7 +840,7 @@ void Game::Tick()
         else if (state_ == GameState::Menu1 || state_ == GameState::MenuCredits) {
             if (Game::IsKeyPressedFromEvent(sf::Keyboard::Return)) {
                 // play
-                GameAssets::Get().successSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().successSoundBuffer, SoundPriority::High);
 
                 ScheduleNewGame();
             }
@@ -832,10 +853,29 @@ void Game::Tick()
                     state_ = GameState::Menu1;
                 }
 
-                GameAssets::Get().selectSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().selectSoundBuffer, SoundPriority::High);
             }
         }
 
+        if (!isPaused_) {
+            stressScene_.Tick(GetWorldArea(), GetPlayerEntity());
+        }
+
+        // simulate the current area at reduced rates away from the player
+        auto area = GetWorldArea();
+        auto lodPlayer = GetPlayerEntity();
+
+        if (area) {
+            area->SetThinkBudget(thinkBudgetMicroseconds_);
+        }
+
+        if (area && lodPlayer) {
+            area->SetSimLodFocus(lodPlayer->GetCenterPosition());
+        }
+        else if (area) {
+            area->ClearSimLodFocus();
+        }
+
         world_->SetDebugMode(debugMode_);
         world_->SetPaused(isPaused_);
 
@@ -844,7 +884,7 @@ void Game::Tick()
 }
 
 
-void Game::RenderUILocation(sf::RenderTarget& target)
+void Game::RenderUILocation(CountingRenderTarget& target)
 {
     if (world_) {
         sf::Text locationText(world_->GetCurrentAreaFsPath(), GameAssets::Get().gameFont, 22);
@@ -856,7 +896,7 @@ void Game::RenderUILocation(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIObjective(sf::RenderTarget& target)
+void Game::RenderUIObjective(CountingRenderTarget& target)
 {
     if (world_ &&
         director_.GetCurrentObjectiveType() != GameObjectiveType::NotStarted &&
@@ -870,7 +910,7 @@ void Game::RenderUIObjective(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIPlayerUseTargetText(sf::RenderTarget& target)
+void Game::RenderUIPlayerUseTargetText(CountingRenderTarget& target)
 {
     auto area = GetWorldArea();
     auto player = GetPlayerEntity();
@@ -906,7 +946,7 @@ void Game::RenderUIPlayerUseTargetText(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIPlayerStats(sf::RenderTarget& target)
+void Game::RenderUIPlayerStats(CountingRenderTarget& target)
 {
     auto player = GetPlayerEntity();
 
@@ -987,7 +1027,7 @@ void Game::RenderUIPlayerStats(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIControls(sf::RenderTarget& target)
+void Game::RenderUIControls(CountingRenderTarget& target)
 {
     if (GetPlayerEntity()) {
         // player-specific controls
@@ -1022,7 +1062,7 @@ void Game::RenderUIControls(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUILoadingNewGame(sf::RenderTarget& target)
+void Game::RenderUILoadingNewGame(CountingRenderTarget& target)
 {
     // render window bg
     sf::RectangleShape uiBg(sf::Vector2f(320.0f, 60.0f));
@@ -1042,7 +1082,7 @@ void Game::RenderUILoadingNewGame(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUILoadingArea(sf::RenderTarget& target)
+void Game::RenderUILoadingArea(CountingRenderTarget& target)
 {
     // render window bg
     sf::RectangleShape uiBg(sf::Vector2f(280.0f, 60.0f));
@@ -1062,7 +1102,7 @@ void Game::RenderUILoadingArea(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIItem(sf::RenderTarget& target, const sf::Vector2f& position, const std::string& label,
+void Game::RenderUIItem(CountingRenderTarget& target, const sf::Vector2f& position, const std::string& label,
     Item* item, bool isHighlighted)
 {
     // render inv item bg and border
@@ -1109,7 +1149,7 @@ void Game::RenderUIItem(sf::RenderTarget& target, const sf::Vector2f& position,
 }
 
 
-void Game::RenderUIPlayerInventory(sf::RenderTarget& target)
+void Game::RenderUIPlayerInventory(CountingRenderTarget& target)
 {
     auto player = GetPlayerEntity();
 
@@ -1291,7 +1331,7 @@ void Game::RenderUIPlayerInventory(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIMessages(sf::RenderTarget& target)
+void Game::RenderUIMessages(CountingRenderTarget& target)
 {
     for (auto it = messages_.rbegin(); it != messages_.rend(); ++it) {
         auto msg = *it;
@@ -1309,7 +1349,7 @@ void Game::RenderUIMessages(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIDisplayedQuestion(sf::RenderTarget& target)
+void Game::RenderUIDisplayedQuestion(CountingRenderTarget& target)
 {
     if (!displayedQuestion_) {
         return;
@@ -1380,7 +1420,7 @@ void Game::RenderUIDisplayedQuestion(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIRespawnSacrifice(sf::RenderTarget& target)
+void Game::RenderUIRespawnSacrifice(CountingRenderTarget& target)
 {
     auto player = GetPlayerEntity();
 
@@ -1499,7 +1539,7 @@ void Game::RenderUIRespawnSacrifice(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUILowStatsWarning(sf::RenderTarget& target)
+void Game::RenderUILowStatsWarning(CountingRenderTarget& target)
 {
     auto player = GetPlayerEntity();
 
@@ -1528,7 +1568,7 @@ void Game::RenderUILowStatsWarning(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIMapMode(sf::RenderTarget& target)
+void Game::RenderUIMapMode(CountingRenderTarget& target)
 {
     sf::Text mapLabel("You are in Map Mode.", GameAssets::Get().gameFont, 16);
     mapLabel.setFillColor(sf::Color(255, 255, 255));
@@ -1544,7 +1584,7 @@ void Game::RenderUIMapMode(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIMenu(sf::RenderTarget& target)
+void Game::RenderUIMenu(CountingRenderTarget& target)
 {
     sf::RectangleShape menuBack(target.getView().getSize());
     menuBack.setPosition(sf::Vector2f());
@@ -1766,7 +1806,7 @@ void Game::RenderUIMenu(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIEndStats(sf::RenderTarget& target)
+void Game::RenderUIEndStats(CountingRenderTarget& target)
 {
     if (director_.GetCurrentObjectiveType() != GameObjectiveType::End) {
         return;
@@ -1878,7 +1918,7 @@ void Game::RenderUIEndStats(sf::RenderTarget& target)
 }
 
 
-void Game::RenderUIPaused(sf::RenderTarget& target)
+void Game::RenderUIPaused(CountingRenderTarget& target)
 {
     if (!isPaused_) {
         return;
@@ -1917,8 +1957,10 @@ void Game::RenderUIPaused(sf::RenderTarget& target)
 }
 
 
-void Game::Render(sf::RenderTarget& target)
+void Game::Render(CountingRenderTarget& target)
 {
+    PROFILE_ZONE("Game::Render");
+
     target.clear();
 
     if (world_) {
@@ -1946,6 +1988,9 @@ void Game::Render(sf::RenderTarget& target)
 
         world_->Render(target);
 
+        RenderPassScope hudPass(target, RenderPass::HUD);
+        PROFILE_ZONE("Game::RenderUI");
+
         // state specific ui
         if (state_ == GameState::InGame) {
             RenderUILocation(target);
@@ -2002,8 +2047,71 @@ void Game::Render(sf::RenderTarget& target)
 
 void Game::RunFrame(sf::RenderTarget& target)
 {
+    Profiler::Get().BeginFrame();
+
     Tick();
-    Render(target);
+
+    CountingRenderTarget countingTarget(target);
+    Render(countingTarget);
+
+    lastFrameRenderStats_ = countingTarget.GetStats();
+    Profiler::Get().SetLastFrameRenderStats(lastFrameRenderStats_);
+    if (reportDraws_) {
+        reportedRenderStats_ += lastFrameRenderStats_;
+        ++reportedRenderFrameCount_;
+    }
+
+    // play this frame's sounds as heard from the view of the current area
+    auto listenerArea = GetWorldArea();
+    if (listenerArea) {
+        auto& listenerView = listenerArea->GetRenderView();
+        AudioQueue::Get().SetListener(listenerArea,
+            sf::FloatRect(listenerView.getCenter() - listenerView.getSize() * 0.5f, listenerView.getSize()));
+    }
+    else {
+        AudioQueue::Get().SetListener(nullptr, sf::FloatRect());
+    }
+
+    AudioQueue::Get().Flush();
 
     eventKeysPressed_.clear();
+
+    Profiler::Get().EndFrame();
+
+    // record how the stress scene's load affected this frame
+    auto area = GetWorldArea();
+    if (area && stressScene_.IsActive()) {
+        static const auto tickZone = Profiler::Get().RegisterZone("Game::Tick");
+        static const auto renderZone = Profiler::Get().RegisterZone("Game::Render");
+
+        stressScene_.RecordFrame(area->GetEntityCount(),
+            Profiler::Get().GetZone(tickZone).lastFrameMicroseconds,
+            Profiler::Get().GetZone(renderZone).lastFrameMicroseconds);
+    }
+}
+
+
+void Game::PrintDrawReport() const
+{
+    if (reportedRenderFrameCount_ == 0) {
+        std::cout << "Draw report - no frames rendered\n";
+        return;
+    }
+
+    std::cout << "Draw report - averages per frame over " << reportedRenderFrameCount_ << " frame(s):\n";
+
+    auto printPassStats = [this](const std::string& name, const RenderPassStats& passStats) {
+        std::cout << "\t" << name << ": "
+            << static_cast<double>(passStats.draws) / reportedRenderFrameCount_ << " draws, "
+            << static_cast<double>(passStats.vertices) / reportedRenderFrameCount_ << " vertices, "
+            << static_cast<double>(passStats.textureSwitches) / reportedRenderFrameCount_ << " texture switches, "
+            << static_cast<double>(passStats.viewChanges) / reportedRenderFrameCount_ << " view changes\n";
+    };
+
+    for (std::size_t i = 0; i < RenderFrameStats::PassCount; ++i) {
+        auto pass = static_cast<RenderPass>(i);
+        printPassStats(RenderFrameStats::GetPassName(pass), reportedRenderStats_.GetPass(pass));
+    }
+
+    printPassStats("Total", reportedRenderStats_.GetTotal());
 }
\ No newline at end of file
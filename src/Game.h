@@ -14,6 +14,8 @@
 #include "GameDirector.h"
 #include "World.h"
 #include "Player.h"
+#include "StressScene.h"
+#include "AudioQueue.h"
 
 /**
 * Struct containing loaded assets
@@ -45,38 +47,7 @@ struct GameAssets
     sf::Texture sparkleSpriteSheet;
     sf::Texture projectileSpriteSheet;
 
-    sf::Sound selectSound;
-    sf::Sound drinkSound;
-    sf::Sound blastSound;
-    sf::Sound waveSound;
-    sf::Sound drainSound;
-    sf::Sound zeroBlastSound;
-    sf::Sound pickupSound;
-    sf::Sound artefactPickupSound;
-    sf::Sound attackSound;
-    sf::Sound hitSound;
-    sf::Sound specSound;
-    sf::Sound lowHealthSound;
-    sf::Sound deathSound;
-    sf::Sound playerHurtSound;
-    sf::Sound playerDeathSound;
-    sf::Sound successSound;
-    sf::Sound failureSound;
-    sf::Sound openChestSound;
-    sf::Sound blockSound;
-    sf::Sound armourPenSound;
-    sf::Sound invincibilitySound;
-    sf::Sound magicFireSound;
-    sf::Sound smokeSound;
-    sf::Sound bossSwordSound;
-    sf::Sound bossSpawnSound;
-    sf::Sound bossDyingSound;
-    sf::Sound bossDeadSound;
-    sf::Sound bossActionSound;
-
-    bool LoadAssets();
-
-private:
+    // played through AudioQueue
     sf::SoundBuffer drinkSoundBuffer;
     sf::SoundBuffer blastSoundBuffer;
     sf::SoundBuffer waveSoundBuffer;
@@ -106,6 +77,8 @@ private:
     sf::SoundBuffer bossDeadSoundBuffer;
     sf::SoundBuffer bossActionSoundBuffer;
 
+    bool LoadAssets();
+
     GameAssets() { }
     ~GameAssets() { }
 };
@@ -175,6 +148,15 @@ class Game
     u32 endPlayerNumQuestionsWrong_;
     sf::Time endPlayerTimeTaken_;
 
+    StressScene stressScene_;
+
+    u64 thinkBudgetMicroseconds_;
+
+    bool reportDraws_;
+    RenderFrameStats lastFrameRenderStats_;
+    RenderFrameStats reportedRenderStats_;
+    u64 reportedRenderFrameCount_;
+
     inline WorldArea* GetWorldArea() { return world_ ? world_->GetCurrentArea() : nullptr; }
     inline const WorldArea* GetWorldArea() const { return world_ ? world_->GetCurrentArea() : nullptr; }
 
@@ -210,11 +192,12 @@ class Game
     bool SpawnPlayer(const sf::Vector2f* optionalStartPos = nullptr);
     bool RemovePlayer();
     bool TeleportPlayerToObjective();
+    bool ShowPathToObjective();
 
     bool ChangeLevel(const std::string& fsNodePath);
     bool NewGame();
 
-    void UpdateCamera(sf::RenderTarget& target);
+    void UpdateCamera(CountingRenderTarget& target);
 
     void HandleDisplayedQuestionInput();
     void HandleRespawnSacrificeInput();
@@ -222,28 +205,28 @@ class Game
     void HandlePlayerMoveInput();
     void HandlePlayerLowHealthBeep();
 
-    void RenderUIMessages(sf::RenderTarget& target);
-    void RenderUIPaused(sf::RenderTarget& target);
-    void RenderUILoadingNewGame(sf::RenderTarget& target);
-    void RenderUILoadingArea(sf::RenderTarget& target);
-    void RenderUILocation(sf::RenderTarget& target);
-    void RenderUIObjective(sf::RenderTarget& target);
-    void RenderUIPlayerStats(sf::RenderTarget& target);
-    void RenderUIItem(sf::RenderTarget& target, const sf::Vector2f& position, const std::string& label,
+    void RenderUIMessages(CountingRenderTarget& target);
+    void RenderUIPaused(CountingRenderTarget& target);
+    void RenderUILoadingNewGame(CountingRenderTarget& target);
+    void RenderUILoadingArea(CountingRenderTarget& target);
+    void RenderUILocation(CountingRenderTarget& target);
+    void RenderUIObjective(CountingRenderTarget& target);
+    void RenderUIPlayerStats(CountingRenderTarget& target);
+    void RenderUIItem(CountingRenderTarget& target, const sf::Vector2f& position, const std::string& label,
         Item* item, bool isHighlighted = false);
-    void RenderUILowStatsWarning(sf::RenderTarget& target);
-    void RenderUIPlayerInventory(sf::RenderTarget& target);
-    void RenderUIDisplayedQuestion(sf::RenderTarget& target);
-    void RenderUIRespawnSacrifice(sf::RenderTarget& target);
-    void RenderUIPlayerUseTargetText(sf::RenderTarget& target);
-    void RenderUIControls(sf::RenderTarget& target);
-    void RenderUIMapMode(sf::RenderTarget& target);
-    void RenderUIEndStats(sf::RenderTarget& target);
+    void RenderUILowStatsWarning(CountingRenderTarget& target);
+    void RenderUIPlayerInventory(CountingRenderTarget& target);
+    void RenderUIDisplayedQuestion(CountingRenderTarget& target);
+    void RenderUIRespawnSacrifice(CountingRenderTarget& target);
+    void RenderUIPlayerUseTargetText(CountingRenderTarget& target);
+    void RenderUIControls(CountingRenderTarget& target);
+    void RenderUIMapMode(CountingRenderTarget& target);
+    void RenderUIEndStats(CountingRenderTarget& target);
 
-    void RenderUIMenu(sf::RenderTarget& target);
+    void RenderUIMenu(CountingRenderTarget& target);
 
     void Tick();
-    void Render(sf::RenderTarget& target);
+    void Render(CountingRenderTarget& target);
 
     Game();
     ~Game();
@@ -313,6 +296,7 @@ public:
     inline void ScheduleNewGame() { scheduledNewGame_ = true; }
 
     inline GameDirector& GetDirector() { return director_; }
+    inline StressScene& GetStressScene() { return stressScene_; }
 
     inline bool IsInMapMode() const { return mapMode_; }
 
@@ -323,5 +307,22 @@ public:
     inline bool IsInDebugMode() const { return debugMode_; }
 
     inline GameState GetCurrentGameState() const { return state_; }
+
+    inline void SetReportDraws(bool reportDraws) { reportDraws_ = reportDraws; }
+    inline bool IsReportingDraws() const { return reportDraws_; }
+
+    /**
+    * How long the Think()s of the current area may take per tick before the rest are put off (0, the
+    * default, for no limit). Limiting it makes how the ents think depend on how fast the machine is.
+    */
+    inline void SetThinkBudget(u64 microseconds) { thinkBudgetMicroseconds_ = microseconds; }
+    inline u64 GetThinkBudget() const { return thinkBudgetMicroseconds_; }
+
+    /**
+    * Returns the draw counters recorded while rendering the last frame.
+    */
+    inline const RenderFrameStats& GetLastFrameRenderStats() const { return lastFrameRenderStats_; }
+
+    void PrintDrawReport() const;
 };
 
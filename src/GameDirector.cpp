@@ -321,24 +321,20 @@ void GameDirector::PopulateWithEnemies(WorldArea* area, float difficultyMul)
         // try spawn enemies
         if (!spawnableEnemies.empty()) {
             for (int i = 0; i < targetEnemies; ++i) {
-                int tryCount = 0;
-
-                while (tryCount++ < 10000) {
-                    auto desiredArea = sf::FloatRect(
-                        Helper::GenerateRandomInt<u32>(0, area->GetWidth() - 1) * BaseTile::TileSize.x,
-                        Helper::GenerateRandomInt<u32>(0, area->GetHeight() - 1) * BaseTile::TileSize.y,
-                        16.0f, 16.0f
-                        );
-
-                    if (area->CheckEntRectangleWalkable(desiredArea)) {
-                        auto chosenEnemyType = spawnableEnemies[Helper::GenerateRandomInt<std::size_t>(0,
-                            spawnableEnemies.size() - 1)];
-                        auto enemyEnt = area->GetEntity<Enemy>(area->EmplaceEntity<BasicEnemy>(chosenEnemyType));
-
-                        if (enemyEnt) {
-                            enemyEnt->SetPosition(sf::Vector2f(desiredArea.left, desiredArea.top));
-                            break;
-                        }
+                // one draw picks the tile; any walkable tile fits an enemy, so nothing is retried
+                auto& walkableTiles = area->GetWalkableTiles();
+                u32 tileX, tileY;
+
+                if (!walkableTiles.empty() && area->FindWalkableTileFrom(
+                    Helper::GenerateRandomInt<std::size_t>(0, walkableTiles.size() - 1), 1,
+                    [](u32, u32) { return true; }, &tileX, &tileY)) {
+                    auto chosenEnemyType = spawnableEnemies[Helper::GenerateRandomInt<std::size_t>(0,
+                        spawnableEnemies.size() - 1)];
+                    auto enemyEnt = area->GetEntity<Enemy>(area->EmplaceEntity<BasicEnemy>(chosenEnemyType));
+
+                    if (enemyEnt) {
+                        enemyEnt->SetPosition(sf::Vector2f(tileX * BaseTile::TileSize.x,
+                            tileY * BaseTile::TileSize.y));
                     }
                 }
             }
@@ -360,6 +356,7 @@ void GameDirector::PlayerChangedArea(WorldArea* newArea, bool updateEnemies)
 
         bool isArtefactFloor = (objective_ == GameObjectiveType::CollectArtefact &&
             objectiveFsNode_ && objectiveFsNode_->GetParent() == newArea->GetRelatedNode());
+        auto artefactChest = isArtefactFloor ? newArea->GetFsNodeEntity<ChestEntity>(objectiveFsNode_) : nullptr;
         bool foundArtefactChest = false;
         int numChestsClosed = 0;
 
@@ -367,7 +364,7 @@ void GameDirector::PlayerChangedArea(WorldArea* newArea, bool updateEnemies)
             auto chestEnt = newArea->GetEntity<ChestEntity>(id);
             assert(chestEnt);
 
-            bool isArtefactChest = isArtefactFloor && objectiveFsNode_->GetName() == chestEnt->GetChestFsNodeName();
+            bool isArtefactChest = chestEnt == artefactChest;
 
             if (chestEnt->IsOpened()) {
                 if (isArtefactChest || Helper::GenerateRandomBool(0.5f)) {
@@ -381,7 +378,7 @@ void GameDirector::PlayerChangedArea(WorldArea* newArea, bool updateEnemies)
                     assert(effect);
                     
                     effect->SetCenterPosition(chestEnt->GetCenterPosition());
-                    GameAssets::Get().drainSound.play();
+                    AudioQueue::Get().PlayAt(GameAssets::Get().drainSoundBuffer, newArea, chestEnt->GetCenterPosition());
                 }
             }
 
@@ -607,7 +604,7 @@ void GameDirector::BossDefeated()
     Game::Get().AddMessage("The magical flames blocking the gilded stairs have been doused!", sf::Color(255, 0, 255));
     Game::Get().AddMessage("Ascend the mysterious stairs to finally exit the dungeon!", sf::Color(255, 0, 255));
 
-    GameAssets::Get().successSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().successSoundBuffer);
 }
 
 
@@ -622,7 +619,7 @@ void GameDirector::EndGame()
     std::cout << "GameDirector - Game ended!\n";
     Game::Get().AddMessage("Well done - you win!");
 
-    GameAssets::Get().invincibilitySound.play();
+    AudioQueue::Get().Play(GameAssets::Get().invincibilitySoundBuffer);
 }
 
 
@@ -1,9 +1,10 @@
 #include "GameFilesystem.h"
 
-#include <sstream>
 #include <cassert>
 #include <iostream>
 
+#include "Log.h"
+
 
 GameFilesystemNode::GameFilesystemNode(const std::string& name, GameFilesystemNodeType type, RngInt randomId) :
 type_(type),
@@ -44,8 +45,7 @@ GameFilesystemNode* GameFilesystemNode::AddChildNode(std::unique_ptr<GameFilesys
         node->parentNode_ = this;
         childNodes_.emplace_back(std::move(node));
 
-        std::cout << "Added: " << GameFilesystem::GetNodePathString(*nodePtr) << " ("
-            << nodePtr->GetRandomIdentifier() << ")\n";
+        LOG_DEBUG("Added: {} ({})", GameFilesystem::LogNodePath(*nodePtr), nodePtr->GetRandomIdentifier());
     }
 
 	return nodePtr;
@@ -74,34 +74,10 @@ void GameFilesystemNode::SetName(const std::string& name)
 
 std::string GameFilesystem::GetNodePathString(const GameFilesystemNode& node)
 {
-	// traverse through nodes to root directory OR root of graph (if no root directory)
-    std::vector<std::string> nodeNamesInPathToRoot;
-
-	// currentNode will be null if the last node was the root of the graph
-	// (or the root directory)!
-	auto currentNode = &node;
-	while (currentNode) {
-        bool isRootNode = currentNode->IsRootDirectoryNode();
-
-        nodeNamesInPathToRoot.emplace_back(isRootNode ? "/" : currentNode->GetName());
-        currentNode = isRootNode ? nullptr : currentNode->GetParent();
-	}
-
-	// construct path str
-	std::ostringstream oss;
-
-    for (auto it = nodeNamesInPathToRoot.rbegin(); it != nodeNamesInPathToRoot.rend(); ++it) {
-        oss << *it;
-
-        // don't print a slash at the beginning OR end of the string
-        // (beginning of string will already have a slash for root)
-        if (it != nodeNamesInPathToRoot.rbegin() &&
-            it != nodeNamesInPathToRoot.rend() - 1) {
-            oss << '/';
-        }
-    }
+	std::string path;
+    WriteNodePath(node, [&path](const char* str, std::size_t length) { path.append(str, length); });
 
-	return oss.str();
+	return path;
 }
 
 
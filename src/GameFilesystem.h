@@ -6,6 +6,7 @@
 #include <cassert>
 #include <stdexcept>
 
+#include "Log.h"
 #include "Types.h"
 
 /**
@@ -116,7 +117,7 @@ public:
     }
 
 	void SetName(const std::string& name);
-	inline std::string GetName() const { return name_; }
+	inline const std::string& GetName() const { return name_; }
 
 	inline GameFilesystemNodeType GetType() const { return type_; }
 
@@ -141,9 +142,55 @@ class GameFilesystem
 {
 	std::unique_ptr<GameFilesystemNode> rootNode_;
 
+    // returns how many nodes up the root of node's path is
+    template <typename Func>
+    static std::size_t WriteNodePathFrom(const GameFilesystemNode& node, Func& write)
+    {
+        std::size_t depth = 0;
+
+        if (!node.IsRootDirectoryNode() && node.GetParent()) {
+            depth = WriteNodePathFrom(*node.GetParent(), write) + 1;
+        }
+
+        // don't print a slash at the beginning OR end of the string
+        // (beginning of string will already have a slash for root)
+        if (depth >= 2) {
+            write("/", 1);
+        }
+
+        if (node.IsRootDirectoryNode()) {
+            write("/", 1);
+        }
+        else {
+            write(node.GetName().c_str(), node.GetName().size());
+        }
+
+        return depth;
+    }
+
 public:
+    /**
+    * Calls write(const char* str, std::size_t length) with each piece of node's path string in turn,
+    * from the root, without building the string.
+    */
+    template <typename Func>
+    static void WriteNodePath(const GameFilesystemNode& node, Func write)
+    {
+        WriteNodePathFrom(node, write);
+    }
+
     static std::string GetNodePathString(const GameFilesystemNode& node);
 
+    /**
+    * Log argument for node's path string; only written out if the message is logged.
+    */
+    static inline auto LogNodePath(const GameFilesystemNode& node)
+    {
+        return LogText([&node](LogRecord& record) {
+            WriteNodePath(node, [&record](const char* str, std::size_t length) { record.AppendString(str, length); });
+        });
+    }
+
 	GameFilesystem();
 	~GameFilesystem();
 
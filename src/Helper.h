@@ -3,10 +3,10 @@
 #include <random>
 #include <memory>
 
-#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Text.hpp>
 
 #include "Types.h"
+#include "CountingRenderTarget.h"
 
 #define PI 3.14159265358979323846f
 
@@ -79,14 +79,14 @@ public:
         return std::move(std::make_unique<sf::Text>(textShadow));
     }
 
-    static inline void RenderTextWithDropShadow(sf::RenderTarget& target, const sf::Text& text, 
+    static inline void RenderTextWithDropShadow(CountingRenderTarget& target, const sf::Text& text, 
         const sf::Vector2f& offset = sf::Vector2f(2.0f, 2.0f), const sf::Color& color = sf::Color(0, 0, 0))
     {
         target.draw(*GetTextDropShadow(text, offset, color));
         target.draw(text);
     }
 
-    static inline sf::Vector2f ComputeGoodAspectSize(sf::RenderTarget& target, float size)
+    static inline sf::Vector2f ComputeGoodAspectSize(CountingRenderTarget& target, float size)
     {
         auto aspectVertMul = static_cast<float>(target.getSize().y) / target.getSize().x;
 
@@ -98,7 +98,7 @@ public:
         }
     }
 
-    static inline void ResetTargetView(sf::RenderTarget& target)
+    static inline void ResetTargetView(CountingRenderTarget& target)
     {
         target.setView(sf::View(sf::FloatRect(0.0f, 0.0f,
             static_cast<float>(target.getSize().x), static_cast<float>(target.getSize().y))));
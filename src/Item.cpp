@@ -125,7 +125,7 @@ void PotionItem::Use(PlayerEntity* player)
 
     if (drankPotion) {
         RemoveAmount(1);
-        GameAssets::Get().drinkSound.play();
+        AudioQueue::Get().Play(GameAssets::Get().drinkSoundBuffer);
     }
 }
 
@@ -576,20 +576,14 @@ void MeleeWeapon::Use(PlayerEntity* player)
         break;
     }
 
-    // get hit ents
-    auto hitEntIds = player->GetAssignedArea()->GetAllWorldEntsInRectangle<Enemy>(hitRect);
-
-    // decide weapon action
-    for (auto id : hitEntIds) {
-        auto ent = player->GetAssignedArea()->GetEntity<Enemy>(id);
-        assert(ent);
-
+    // decide weapon action for each hit ent
+    player->GetAssignedArea()->ForEachInRect<Enemy>(hitRect, [&](Enemy* ent) {
         if (!ent->GetStats() || !ent->GetStats()->IsAlive()) {
-            continue;
+            return;
         }
 
         // hit sound
-        GameAssets::Get().hitSound.play();
+        AudioQueue::Get().PlayAt(GameAssets::Get().hitSoundBuffer, ent->GetAssignedArea(), ent->GetCenterPosition());
 
         // damage enemy
         switch (meleeWeaponType_) {
@@ -610,7 +604,7 @@ void MeleeWeapon::Use(PlayerEntity* player)
 
         case MeleeWeaponType::ShardBlade:
             if (Helper::GenerateRandomBool(1 / 10.0f)) {
-                GameAssets::Get().specSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().specSoundBuffer);
                 ent->Attack(Helper::GenerateRandomInt<u32>(0, GetAttack() * 2), DamageType::Magic);
             }
             else {
@@ -639,7 +633,7 @@ void MeleeWeapon::Use(PlayerEntity* player)
         case MeleeWeaponType::Zeraleth:
             if (ent->GetEnemyType() == EnemyType::GhostBasic ||
                 ent->GetEnemyType() == EnemyType::SkeletonBasic) {
-                GameAssets::Get().specSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().specSoundBuffer);
                 ent->Attack(Helper::GenerateRandomInt<u32>(GetAttack() * 2, GetAttack() * 4), DamageType::Other);
             }
             else {
@@ -652,7 +646,7 @@ void MeleeWeapon::Use(PlayerEntity* player)
                 ent->GetEnemyType() == EnemyType::BlueBlobBasic ||
                 ent->GetEnemyType() == EnemyType::RedBlobBasic ||
                 ent->GetEnemyType() == EnemyType::PinkBlobBasic) {
-                GameAssets::Get().specSound.play();
+                AudioQueue::Get().Play(GameAssets::Get().specSoundBuffer);
                 ent->Attack(Helper::GenerateRandomInt<u32>(GetAttack() * 4, GetAttack() * 5), DamageType::Other);
             }
             else {
@@ -688,9 +682,9 @@ void MeleeWeapon::Use(PlayerEntity* player)
             ent->MoveWithCollision(sf::Vector2f(4.0f, 0.0f));
             break;
         }
-    }
+    });
 
-    GameAssets::Get().attackSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().attackSoundBuffer);
     player->PlayAttackAnimation(PlayerSelectedWeapon::Melee);
 }
 
@@ -937,19 +931,19 @@ void MagicWeapon::Use(PlayerEntity* player)
                 case MagicWeaponType::ZeroStaff:
                     effectId = player->GetAssignedArea()->EmplaceEntity<DamageEffectEntity>(DamageEffectType::Zero,
                         sf::seconds(0.5f));
-                    GameAssets::Get().zeroBlastSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().zeroBlastSoundBuffer);
                     break;
 
                 case MagicWeaponType::FlameStaff:
                     effectId = player->GetAssignedArea()->EmplaceEntity<DamageEffectEntity>(DamageEffectType::Flame,
                         sf::seconds(0.5f));
-                    GameAssets::Get().blastSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().blastSoundBuffer);
                     break;
 
                 case MagicWeaponType::DrainStaff:
                     effectId = player->GetAssignedArea()->EmplaceEntity<DamageEffectEntity>(DamageEffectType::Drain,
                         sf::seconds(0.5f));
-                    GameAssets::Get().drainSound.play();
+                    AudioQueue::Get().Play(GameAssets::Get().drainSoundBuffer);
                     break;
                 }
 
@@ -966,7 +960,7 @@ void MagicWeapon::Use(PlayerEntity* player)
     case MagicWeaponType::InvincibilityStaff:
         // invincibility
         player->SetInvincibility(sf::seconds(10.0f));
-        GameAssets::Get().invincibilitySound.play();
+        AudioQueue::Get().Play(GameAssets::Get().invincibilitySoundBuffer);
         break;
 
     case MagicWeaponType::WaveStaff:
@@ -998,11 +992,11 @@ void MagicWeapon::Use(PlayerEntity* player)
         projectile->SetCenterPosition(player->GetCenterPosition() + projectileDir * 8.0f);
         projectile->SetDamage(Helper::GenerateRandomInt<u32>(0, GetAttack()));
 
-        GameAssets::Get().waveSound.play();
+        AudioQueue::Get().Play(GameAssets::Get().waveSoundBuffer);
         break;
     }
 
-    GameAssets::Get().attackSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().attackSoundBuffer);
     player->PlayAttackAnimation(PlayerSelectedWeapon::Magic);
 }
 
@@ -1044,6 +1038,7 @@ ItemEntity::ItemEntity() :
 UnitEntity()
 {
     SetSize(sf::Vector2f(16.0f, 16.0f));
+    SetCollisionLayer(CollisionLayer::Pickup);
 }
 
 
@@ -1057,10 +1052,14 @@ void ItemEntity::Tick()
     if (!item_ || item_->GetAmount() <= 0) {
         MarkForDeletion();
     }
+    else {
+        // nothing to check again until a player picks from us
+        SetDormant(true);
+    }
 }
 
 
-void ItemEntity::Render(sf::RenderTarget& target)
+void ItemEntity::Render(CountingRenderTarget& target)
 {
     if (item_ && item_->GetAmount() > 0) {
         auto itemSprite = item_->GetSprite();
@@ -6,7 +6,6 @@
 #include <sstream>
 
 #include <SFML/System/Time.hpp>
-#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 
 #include "Entity.h"
@@ -337,7 +336,7 @@ public:
     virtual ~ItemEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     virtual void Use(EntityId playerId) override;
 
@@ -382,5 +381,5 @@ public:
 
     inline virtual std::string GetUnitName() const override { return item_ ? item_->GetItemName() : "Item"; }
 
-    inline virtual std::string GetName() const override { return "ItemEntity"; }
+    inline virtual const char* GetName() const override { return "ItemEntity"; }
 };
@@ -0,0 +1,175 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+
+JobSystem::JobSystem() :
+queuedCount_(0),
+running_(false)
+{
+    queues_.emplace_back(std::make_unique<JobQueue>());
+}
+
+
+JobSystem::~JobSystem()
+{
+    Stop();
+}
+
+
+std::size_t JobSystem::GetDefaultWorkerCount()
+{
+    auto hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+
+void JobSystem::Start(std::size_t workerCount)
+{
+    Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = true;
+    }
+
+    queues_.resize(1);
+
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        queues_.emplace_back(std::make_unique<JobQueue>());
+    }
+
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        threads_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+    }
+}
+
+
+void JobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+
+    wakeCondition_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    threads_.clear();
+}
+
+
+bool JobSystem::TryTakeJob(std::size_t queueIndex, Job& outJob)
+{
+    // own queue first (newest job, likely still warm in cache)...
+    {
+        auto& queue = *queues_[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty()) {
+            outJob = queue.jobs.back();
+            queue.jobs.pop_back();
+            queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // ...then steal the oldest job from somebody else
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+        auto& queue = *queues_[(queueIndex + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty()) {
+            outJob = queue.jobs.front();
+            queue.jobs.pop_front();
+            queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void JobSystem::RunJob(const Job& job)
+{
+    (*job.func)(job.begin, job.end);
+
+    // notifying under the lock means the caller can't return (& free the group) until we're done with it
+    std::lock_guard<std::mutex> lock(job.group->mutex);
+    if (--job.group->remaining == 0) {
+        job.group->doneCondition.notify_one();
+    }
+}
+
+
+void JobSystem::WorkerMain(std::size_t queueIndex)
+{
+    while (true) {
+        Job job;
+
+        if (TryTakeJob(queueIndex, job)) {
+            RunJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait(lock, [this] {
+            return !running_ || queuedCount_.load(std::memory_order_relaxed) > 0;
+        });
+
+        if (!running_) {
+            return;
+        }
+    }
+}
+
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grainSize, const RangeFunc& func,
+    std::size_t minParallelCount)
+{
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<std::size_t>(1, grainSize);
+
+    if (threads_.empty() || count <= grainSize || count < minParallelCount) {
+        func(0, count);
+        return;
+    }
+
+    auto chunkCount = (count + grainSize - 1) / grainSize;
+
+    JobGroup group;
+    group.remaining = chunkCount;
+
+    // deal the chunks out round-robin so every worker starts with some of its own
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        auto& queue = *queues_[chunk % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.jobs.push_back(Job{&func, chunk * grainSize, std::min(count, (chunk + 1) * grainSize), &group});
+        queuedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        // taking the lock orders the notify after any worker's check of queuedCount_
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCondition_.notify_all();
+
+    // help out until there's nothing left to take, then wait for the chunks still running elsewhere
+    Job job;
+    while (TryTakeJob(0, job)) {
+        RunJob(job);
+    }
+
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.doneCondition.wait(lock, [&group] { return group.remaining == 0; });
+}
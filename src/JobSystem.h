@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Types.h"
+
+/**
+* Work-stealing pool of worker threads for data-parallel loops.
+* Each worker has its own queue of jobs & takes from the back of it, stealing from the front of
+* the others' when it runs dry. The thread calling ParallelFor() helps out until there's nothing left to
+* take, then sleeps until the workers finish the rest. With no workers started, everything runs inline on
+* the calling thread.
+*/
+class JobSystem
+{
+public:
+    typedef std::function<void(std::size_t, std::size_t)> RangeFunc;
+
+private:
+    // the chunks of a ParallelFor() call still to finish; the last to finish wakes the caller
+    struct JobGroup
+    {
+        std::size_t remaining;
+        std::mutex mutex;
+        std::condition_variable doneCondition;
+    };
+
+    struct Job
+    {
+        const RangeFunc* func;
+        std::size_t begin, end;
+        JobGroup* group;
+    };
+
+    struct JobQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // queue 0 belongs to the thread calling ParallelFor(); the rest to each worker
+    std::vector<std::unique_ptr<JobQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::atomic<std::size_t> queuedCount_;
+    bool running_;
+
+    bool TryTakeJob(std::size_t queueIndex, Job& outJob);
+    static void RunJob(const Job& job);
+
+    void WorkerMain(std::size_t queueIndex);
+
+public:
+    JobSystem();
+    ~JobSystem();
+
+    static inline JobSystem& Get()
+    {
+        static JobSystem instance;
+        return instance;
+    }
+
+    /**
+    * Starts workerCount worker threads, stopping any already running.
+    */
+    void Start(std::size_t workerCount);
+    void Stop();
+
+    /**
+    * Calls func(begin, end) over [0, count) split into chunks of at most grainSize, spread across the
+    * workers. Returns once every chunk has run. Chunks may run in any order & on any thread, so func
+    * must not depend on either. Runs func(0, count) inline if count is below minParallelCount (or fits in a
+    * single chunk), where handing the work out would cost more than it saves.
+    */
+    void ParallelFor(std::size_t count, std::size_t grainSize, const RangeFunc& func,
+        std::size_t minParallelCount = 0);
+
+    inline std::size_t GetWorkerCount() const { return threads_.size(); }
+
+    /**
+    * Worker count to use by default; one less than the hardware threads, leaving one for the game thread.
+    */
+    static std::size_t GetDefaultWorkerCount();
+};
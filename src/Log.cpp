@@ -0,0 +1,237 @@
+#include "Log.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+
+const std::size_t LogRecord::MaxArgs;
+const std::size_t LogRecord::MaxText;
+const std::size_t Logger::RingSize;
+
+
+void LogRecord::AddString(const char* str, std::size_t length)
+{
+    auto& arg = args[argCount++];
+    arg.type = Arg::Type::String;
+    arg.str.offset = textUsed;
+    arg.str.length = 0;
+
+    AppendString(str, length);
+}
+
+
+void LogRecord::AppendString(const char* str, std::size_t length)
+{
+    // strings are copied into the record's text buffer & truncated if it runs out
+    auto& arg = args[argCount - 1];
+    assert(arg.type == Arg::Type::String && arg.str.offset + arg.str.length == textUsed);
+
+    length = std::min(length, MaxText - textUsed);
+
+    std::memcpy(text.data() + textUsed, str, length);
+    arg.str.length += static_cast<u16>(length);
+    textUsed += static_cast<u16>(length);
+}
+
+
+std::string LogRecord::FormatMessage() const
+{
+    std::ostringstream ss;
+    std::size_t nextArg = 0;
+
+    for (auto c = format; *c != '\0'; ++c) {
+        if (c[0] == '{' && c[1] == '}' && nextArg < argCount) {
+            auto& arg = args[nextArg++];
+
+            switch (arg.type) {
+            case Arg::Type::Int:
+                ss << arg.i;
+                break;
+
+            case Arg::Type::UInt:
+                ss << arg.u;
+                break;
+
+            case Arg::Type::Real:
+                ss << arg.d;
+                break;
+
+            case Arg::Type::Bool:
+                ss << (arg.b ? "true" : "false");
+                break;
+
+            case Arg::Type::String:
+                ss.write(text.data() + arg.str.offset, arg.str.length);
+                break;
+            }
+
+            ++c;
+        }
+        else {
+            ss << *c;
+        }
+    }
+
+    return ss.str();
+}
+
+
+Logger::Logger() :
+enqueuePos_(0),
+dequeuePos_(0),
+writtenCount_(0),
+droppedCount_(0),
+reportedDroppedCount_(0),
+running_(true)
+{
+    for (std::size_t i = 0; i < RingSize; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread(&Logger::ThreadMain, this);
+}
+
+
+Logger::~Logger()
+{
+    Shutdown();
+}
+
+
+const char* Logger::GetLevelName(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Trace:
+        return "TRACE";
+
+    case LogLevel::Debug:
+        return "DEBUG";
+
+    case LogLevel::Info:
+        return "INFO";
+
+    case LogLevel::Warn:
+        return "WARN";
+
+    default:
+        return "ERROR";
+    }
+}
+
+
+LogRecord* Logger::BeginRecord(std::size_t& outPos)
+{
+    // bounded multi-producer queue; each slot's sequence says whose turn it is
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+
+    while (true) {
+        auto& record = ring_[pos % RingSize];
+        auto sequence = record.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                outPos = pos;
+                return &record;
+            }
+        }
+        else if (diff < 0) {
+            // ring is full; drop rather than stall the game
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+void Logger::CommitRecord(LogRecord& record, std::size_t pos)
+{
+    record.sequence.store(pos + 1, std::memory_order_release);
+}
+
+
+void Logger::WriteRecord(const LogRecord& record)
+{
+    auto& os = record.level >= LogLevel::Warn ? std::cerr : std::cout;
+    os << GetLevelName(record.level) << " - " << record.FormatMessage() << '\n';
+}
+
+
+bool Logger::DrainRecords()
+{
+    bool wroteAny = false;
+
+    while (true) {
+        auto& record = ring_[dequeuePos_ % RingSize];
+
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            break;
+        }
+
+        WriteRecord(record);
+
+        record.sequence.store(dequeuePos_ + RingSize, std::memory_order_release);
+        ++dequeuePos_;
+
+        writtenCount_.fetch_add(1, std::memory_order_release);
+        wroteAny = true;
+    }
+
+    auto droppedCount = droppedCount_.load(std::memory_order_relaxed);
+    if (droppedCount != reportedDroppedCount_) {
+        std::cerr << "WARN - Logger - dropped " << (droppedCount - reportedDroppedCount_)
+            << " message(s); ring buffer was full\n";
+        reportedDroppedCount_ = droppedCount;
+    }
+
+    if (wroteAny) {
+        std::cout.flush();
+    }
+
+    return wroteAny;
+}
+
+
+void Logger::ThreadMain()
+{
+    while (running_.load(std::memory_order_acquire)) {
+        if (!DrainRecords()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // catch anything queued while we were stopping
+    DrainRecords();
+}
+
+
+void Logger::Flush()
+{
+    if (!running_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    auto target = enqueuePos_.load(std::memory_order_acquire);
+    while (writtenCount_.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+
+void Logger::Shutdown()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "Types.h"
+
+/**
+* Severity of a log message
+*/
+enum class LogLevel : u8
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+/**
+* Minimum level compiled in; messages below it cost nothing (their
+* arguments aren't even evaluated). Override with -DUOLEDUGAME_LOG_LEVEL=n.
+*/
+#ifndef UOLEDUGAME_LOG_LEVEL
+#ifdef NDEBUG
+#define UOLEDUGAME_LOG_LEVEL 2
+#else
+#define UOLEDUGAME_LOG_LEVEL 1
+#endif
+#endif
+
+#define LOG_AT_LEVEL(level, ...) \
+    do { \
+        if (static_cast<int>(level) >= UOLEDUGAME_LOG_LEVEL) { \
+            Logger::Get().Write(level, __VA_ARGS__); \
+        } \
+    } while (false)
+
+#define LOG_TRACE(...) LOG_AT_LEVEL(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT_LEVEL(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT_LEVEL(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT_LEVEL(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_LEVEL(LogLevel::Error, __VA_ARGS__)
+
+struct LogRecord;
+
+/**
+* An argument whose text is written straight into the record by a callable taking
+* a LogRecord& (through LogRecord::AppendString()), only if the message is captured.
+* Lets callers log things like fs paths without building a std::string for them.
+*/
+template <typename Func>
+struct LogTextArg
+{
+    Func write;
+};
+
+template <typename Func>
+inline LogTextArg<Func> LogText(Func write) { return LogTextArg<Func>{ write }; }
+
+/**
+* A captured log message. Arguments are stored raw & only formatted into the
+* format string's {} placeholders once the logging thread writes it out.
+*/
+struct LogRecord
+{
+    static const std::size_t MaxArgs = 8;
+    static const std::size_t MaxText = 160;
+
+    struct Arg
+    {
+        enum class Type : u8
+        {
+            Int,
+            UInt,
+            Real,
+            Bool,
+            String
+        };
+
+        Type type;
+
+        union
+        {
+            i64 i;
+            u64 u;
+            double d;
+            bool b;
+            struct
+            {
+                u16 offset;
+                u16 length;
+            } str;
+        };
+    };
+
+    std::atomic<std::size_t> sequence;
+
+    LogLevel level;
+    const char* format;
+
+    u8 argCount;
+    std::array<Arg, MaxArgs> args;
+
+    u16 textUsed;
+    std::array<char, MaxText> text;
+
+    void AddString(const char* str, std::size_t length);
+
+    /**
+    * Appends to the text of the last argument added, which must be a string.
+    */
+    void AppendString(const char* str, std::size_t length);
+
+    inline void AddArg(bool value)
+    {
+        auto& arg = args[argCount++];
+        arg.type = Arg::Type::Bool;
+        arg.b = value;
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type AddArg(T value)
+    {
+        auto& arg = args[argCount++];
+        arg.type = Arg::Type::Int;
+        arg.i = static_cast<i64>(value);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type AddArg(T value)
+    {
+        auto& arg = args[argCount++];
+        arg.type = Arg::Type::UInt;
+        arg.u = static_cast<u64>(value);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value>::type AddArg(T value)
+    {
+        auto& arg = args[argCount++];
+        arg.type = Arg::Type::Real;
+        arg.d = static_cast<double>(value);
+    }
+
+    inline void AddArg(const char* value) { AddString(value, std::char_traits<char>::length(value)); }
+    inline void AddArg(const std::string& value) { AddString(value.c_str(), value.size()); }
+
+    template <typename Func>
+    inline void AddArg(const LogTextArg<Func>& value)
+    {
+        AddString("", 0);
+        value.write(*this);
+    }
+
+    std::string FormatMessage() const;
+};
+
+/**
+* Leveled logger. Callers copy their message into a lock-free ring buffer and
+* return; a background thread formats & writes the messages out. Messages are
+* dropped (and counted) rather than blocking when the ring is full.
+*/
+class Logger
+{
+    static const std::size_t RingSize = 1024;
+
+    std::array<LogRecord, RingSize> ring_;
+
+    std::atomic<std::size_t> enqueuePos_;
+    std::size_t dequeuePos_;
+
+    std::atomic<u64> writtenCount_;
+    std::atomic<u64> droppedCount_;
+    u64 reportedDroppedCount_;
+
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    Logger();
+    ~Logger();
+
+    LogRecord* BeginRecord(std::size_t& outPos);
+    void CommitRecord(LogRecord& record, std::size_t pos);
+
+    bool DrainRecords();
+    void ThreadMain();
+
+    static void WriteRecord(const LogRecord& record);
+
+    inline void CaptureArgs(LogRecord&) { }
+
+    template <typename T, typename... Args>
+    inline void CaptureArgs(LogRecord& record, const T& arg, const Args&... args)
+    {
+        record.AddArg(arg);
+        CaptureArgs(record, args...);
+    }
+
+    template <typename... Args>
+    inline void FillRecord(LogRecord& record, LogLevel level, const char* format, const Args&... args)
+    {
+        record.level = level;
+        record.format = format;
+        record.argCount = 0;
+        record.textUsed = 0;
+        CaptureArgs(record, args...);
+    }
+
+public:
+    static inline Logger& Get()
+    {
+        static Logger instance;
+        return instance;
+    }
+
+    static const char* GetLevelName(LogLevel level);
+
+    /**
+    * Queues a message. format must be a string literal (it's kept by pointer);
+    * each {} in it is replaced by the next argument.
+    */
+    template <typename... Args>
+    void Write(LogLevel level, const char* format, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= LogRecord::MaxArgs, "Too many arguments for a log message!");
+
+        if (!running_.load(std::memory_order_acquire)) {
+            // logging thread isn't around; write it out now
+            LogRecord record;
+            FillRecord(record, level, format, args...);
+            WriteRecord(record);
+            return;
+        }
+
+        std::size_t pos;
+        auto record = BeginRecord(pos);
+
+        if (!record) {
+            return;
+        }
+
+        FillRecord(*record, level, format, args...);
+        CommitRecord(*record, pos);
+
+        // make sure errors are out before anything that might follow them (e.g. a crash)
+        if (level >= LogLevel::Error) {
+            Flush();
+        }
+    }
+
+    /**
+    * Blocks until everything queued so far has been written out.
+    */
+    void Flush();
+
+    /**
+    * Writes out everything queued & stops the logging thread. Messages logged
+    * afterwards are written synchronously.
+    */
+    void Shutdown();
+
+    inline u64 GetDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+};
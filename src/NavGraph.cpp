@@ -0,0 +1,380 @@
+#include "NavGraph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+#include "Profiler.h"
+#include "World.h"
+
+
+const u32 NavGraph::NoRegion;
+const u32 NavGraph::NoPortal;
+const u32 NavGraph::Unreached;
+const std::size_t NavGraph::MaxCachedPortalPaths;
+
+
+NavGraph::NavGraph(const WorldArea& area, const std::unordered_map<u32, u32>& genRegions) :
+w_(area.GetWidth()),
+h_(area.GetHeight())
+{
+    PROFILE_ZONE("NavGraph::NavGraph");
+
+    auto getGenRegion = [&](u32 tile) {
+        auto it = genRegions.find(tile);
+        return it != genRegions.end() ? it->second : NoRegion;
+    };
+    auto isWalkable = [&](u32 tile) { return area.GetTileClearance(tile % w_, tile / w_) > 0; };
+
+    // split what the generator placed into connected pieces; a room or passage can be cut in two by later ones
+    auto& walkableTiles = area.GetWalkableTiles();
+    tileRegions_.reserve(walkableTiles.size());
+
+    std::vector<u32> fillStack;
+    u32 maxRegionSize = 0;
+
+    for (auto& walkableTile : walkableTiles) {
+        auto tile = walkableTile.y * w_ + walkableTile.x;
+        if (tileRegions_.count(tile) > 0) {
+            continue;
+        }
+
+        auto genRegion = getGenRegion(tile);
+        auto region = static_cast<u32>(regionPortals_.size());
+        regionPortals_.emplace_back();
+
+        u32 regionSize = 0;
+        tileRegions_.emplace(tile, TileRegion{ region, regionSize++ });
+        fillStack.push_back(tile);
+
+        while (!fillStack.empty()) {
+            auto fillTile = fillStack.back();
+            fillStack.pop_back();
+
+            auto x = fillTile % w_;
+            auto y = fillTile / w_;
+            const u32 neighbours[4] = {
+                x > 0 ? fillTile - 1 : fillTile, x + 1 < w_ ? fillTile + 1 : fillTile,
+                y > 0 ? fillTile - w_ : fillTile, y + 1 < h_ ? fillTile + w_ : fillTile
+            };
+
+            for (auto neighbour : neighbours) {
+                if (getGenRegion(neighbour) == genRegion && isWalkable(neighbour) &&
+                    tileRegions_.emplace(neighbour, TileRegion{ region, regionSize }).second) {
+                    ++regionSize;
+                    fillStack.push_back(neighbour);
+                }
+            }
+        }
+
+        maxRegionSize = std::max(maxRegionSize, regionSize);
+    }
+
+    tileDist_.assign(maxRegionSize, Unreached);
+    tileParent_.assign(maxRegionSize, 0);
+
+    // portals either side of each border between regions, linked by a step
+    std::unordered_map<u32, u32> tilePortals;
+
+    auto getPortal = [&](u32 tile, u32 region) {
+        auto it = tilePortals.find(tile);
+        if (it != tilePortals.end()) {
+            return it->second;
+        }
+
+        auto portal = static_cast<u32>(portals_.size());
+        portals_.push_back(Portal{ tile, region, {} });
+        regionPortals_[region].push_back(portal);
+        tilePortals.emplace(tile, portal);
+        return portal;
+    };
+
+    for (auto& walkableTile : walkableTiles) {
+        auto tile = walkableTile.y * w_ + walkableTile.x;
+        auto region = FindTileRegion(tile)->region;
+
+        const u32 neighbours[2] = {
+            walkableTile.x + 1 < w_ ? tile + 1 : tile, walkableTile.y + 1 < h_ ? tile + w_ : tile
+        };
+
+        for (auto neighbour : neighbours) {
+            auto neighbourRegion = FindTileRegion(neighbour);
+            if (!neighbourRegion || neighbourRegion->region == region) {
+                continue;
+            }
+
+            auto a = getPortal(tile, region);
+            auto b = getPortal(neighbour, neighbourRegion->region);
+            portals_[a].links.emplace_back(b, 1);
+            portals_[b].links.emplace_back(a, 1);
+        }
+    }
+
+    // & to each other within their region by the length of the path between them
+    for (u32 region = 0; region < regionPortals_.size(); ++region) {
+        auto& portals = regionPortals_[region];
+
+        for (auto portal : portals) {
+            SearchRegion(region, portals_[portal].tile);
+
+            for (auto other : portals) {
+                if (other != portal) {
+                    portals_[portal].links.emplace_back(other, GetRegionSearchDistance(portals_[other].tile));
+                }
+            }
+        }
+    }
+
+    ResetRegionSearch();
+
+    portalCost_.assign(portals_.size(), Unreached);
+    portalParent_.assign(portals_.size(), NoPortal);
+    portalGoalCost_.assign(portals_.size(), Unreached);
+
+    LOG_DEBUG("NavGraph - Built {} region(s) & {} portal(s)", regionPortals_.size(), portals_.size());
+}
+
+
+NavGraph::~NavGraph()
+{
+}
+
+
+const NavGraph::TileRegion* NavGraph::FindTileRegion(u32 tile) const
+{
+    auto it = tileRegions_.find(tile);
+    return it != tileRegions_.end() ? &it->second : nullptr;
+}
+
+
+void NavGraph::SearchRegion(u32 region, u32 fromTile) const
+{
+    ResetRegionSearch();
+
+    auto fromIndex = FindTileRegion(fromTile)->regionIndex;
+    tileDist_[fromIndex] = 0;
+    tileParent_[fromIndex] = fromTile;
+    tileReached_.emplace_back(fromTile, fromIndex);
+
+    for (std::size_t head = 0; head < tileReached_.size(); ++head) {
+        auto tile = tileReached_[head].first;
+        auto dist = tileDist_[tileReached_[head].second];
+        auto x = tile % w_;
+        auto y = tile / w_;
+        const u32 neighbours[4] = {
+            x > 0 ? tile - 1 : tile, x + 1 < w_ ? tile + 1 : tile,
+            y > 0 ? tile - w_ : tile, y + 1 < h_ ? tile + w_ : tile
+        };
+
+        for (auto neighbour : neighbours) {
+            auto neighbourRegion = FindTileRegion(neighbour);
+            if (!neighbourRegion || neighbourRegion->region != region) {
+                continue;
+            }
+
+            auto neighbourIndex = neighbourRegion->regionIndex;
+            if (tileDist_[neighbourIndex] == Unreached) {
+                tileDist_[neighbourIndex] = dist + 1;
+                tileParent_[neighbourIndex] = tile;
+                tileReached_.emplace_back(neighbour, neighbourIndex);
+            }
+        }
+    }
+}
+
+
+u32 NavGraph::GetRegionSearchDistance(u32 tile) const
+{
+    return tileDist_[FindTileRegion(tile)->regionIndex];
+}
+
+
+void NavGraph::ResetRegionSearch() const
+{
+    for (auto& reached : tileReached_) {
+        tileDist_[reached.second] = Unreached;
+    }
+
+    tileReached_.clear();
+}
+
+
+void NavGraph::AppendRegionPath(u32 fromTile, u32 toTile, std::vector<u32>& outTiles) const
+{
+    // walk back from toTile along the last search (which must have been from fromTile), then flip it
+    auto begin = outTiles.size();
+
+    for (auto tile = toTile; tile != fromTile; tile = tileParent_[FindTileRegion(tile)->regionIndex]) {
+        outTiles.push_back(tile);
+    }
+
+    std::reverse(outTiles.begin() + begin, outTiles.end());
+}
+
+
+void NavGraph::AppendPortalPath(u32 fromPortal, u32 toPortal, std::vector<u32>& outTiles) const
+{
+    auto key = (static_cast<u64>(fromPortal) << 32) | toPortal;
+    auto it = portalPathCache_.find(key);
+
+    if (it == portalPathCache_.end()) {
+        auto fromTile = portals_[fromPortal].tile;
+        std::vector<u32> tiles;
+
+        SearchRegion(portals_[fromPortal].region, fromTile);
+        AppendRegionPath(fromTile, portals_[toPortal].tile, tiles);
+
+        if (portalPathCache_.size() >= MaxCachedPortalPaths) {
+            portalPathCache_.clear();
+        }
+
+        it = portalPathCache_.emplace(key, std::move(tiles)).first;
+    }
+
+    outTiles.insert(outTiles.end(), it->second.begin(), it->second.end());
+}
+
+
+u32 NavGraph::GetHeuristic(u32 tile, u32 goalTile) const
+{
+    // manhattan; paths only take straight steps
+    auto dx = static_cast<i64>(tile % w_) - static_cast<i64>(goalTile % w_);
+    auto dy = static_cast<i64>(tile / w_) - static_cast<i64>(goalTile / w_);
+    return static_cast<u32>(std::abs(dx) + std::abs(dy));
+}
+
+
+bool NavGraph::FindPath(u32 fromX, u32 fromY, u32 toX, u32 toY, std::vector<sf::Vector2u>* outPath) const
+{
+    PROFILE_ZONE("NavGraph::FindPath");
+
+    auto fromRegion = GetTileRegion(fromX, fromY);
+    auto toRegion = GetTileRegion(toX, toY);
+
+    if (fromRegion == NoRegion || toRegion == NoRegion) {
+        return false;
+    }
+
+    auto fromTile = fromY * w_ + fromX;
+    auto toTile = toY * w_ + toX;
+    pathScratch_.clear();
+
+    if (fromRegion == toRegion) {
+        SearchRegion(fromRegion, fromTile);
+        AppendRegionPath(fromTile, toTile, pathScratch_);
+    }
+    else {
+        // costs from the portals of the goal's region to the goal, then from the start to those of its own
+        SearchRegion(toRegion, toTile);
+        for (auto portal : regionPortals_[toRegion]) {
+            portalGoalCost_[portal] = GetRegionSearchDistance(portals_[portal].tile);
+        }
+
+        SearchRegion(fromRegion, fromTile);
+        openScratch_.clear();
+
+        for (auto portal : regionPortals_[fromRegion]) {
+            portalCost_[portal] = GetRegionSearchDistance(portals_[portal].tile);
+            portalParent_[portal] = NoPortal;
+            portalTouched_.push_back(portal);
+
+            openScratch_.emplace_back(portalCost_[portal] + GetHeuristic(portals_[portal].tile, toTile), portal);
+            std::push_heap(openScratch_.begin(), openScratch_.end(), std::greater<std::pair<u32, u32>>());
+        }
+
+        auto bestCost = Unreached;
+        auto bestPortal = NoPortal;
+
+        while (!openScratch_.empty()) {
+            std::pop_heap(openScratch_.begin(), openScratch_.end(), std::greater<std::pair<u32, u32>>());
+            auto estimate = openScratch_.back().first;
+            auto portal = openScratch_.back().second;
+            openScratch_.pop_back();
+
+            // nothing left can beat the best path to the goal found so far
+            if (estimate >= bestCost) {
+                break;
+            }
+
+            // stale; a cheaper way here was found after this was queued
+            auto cost = portalCost_[portal];
+            if (estimate != cost + GetHeuristic(portals_[portal].tile, toTile)) {
+                continue;
+            }
+
+            if (portalGoalCost_[portal] != Unreached && cost + portalGoalCost_[portal] < bestCost) {
+                bestCost = cost + portalGoalCost_[portal];
+                bestPortal = portal;
+            }
+
+            for (auto& link : portals_[portal].links) {
+                auto linkCost = cost + link.second;
+
+                if (linkCost < portalCost_[link.first]) {
+                    if (portalCost_[link.first] == Unreached) {
+                        portalTouched_.push_back(link.first);
+                    }
+
+                    portalCost_[link.first] = linkCost;
+                    portalParent_[link.first] = portal;
+
+                    openScratch_.emplace_back(linkCost + GetHeuristic(portals_[link.first].tile, toTile), link.first);
+                    std::push_heap(openScratch_.begin(), openScratch_.end(), std::greater<std::pair<u32, u32>>());
+                }
+            }
+        }
+
+        // the portals crossed, first to last
+        chainScratch_.clear();
+        for (auto portal = bestPortal; portal != NoPortal; portal = portalParent_[portal]) {
+            chainScratch_.push_back(portal);
+        }
+        std::reverse(chainScratch_.begin(), chainScratch_.end());
+
+        for (auto portal : portalTouched_) {
+            portalCost_[portal] = Unreached;
+        }
+        portalTouched_.clear();
+
+        for (auto portal : regionPortals_[toRegion]) {
+            portalGoalCost_[portal] = Unreached;
+        }
+
+        if (chainScratch_.empty()) {
+            ResetRegionSearch();
+            return false;
+        }
+
+        // fill in the tiles; the last search was from the start, so that leg can be walked straight away
+        AppendRegionPath(fromTile, portals_[chainScratch_.front()].tile, pathScratch_);
+
+        for (std::size_t i = 1; i < chainScratch_.size(); ++i) {
+            auto prevPortal = chainScratch_[i - 1];
+            auto portal = chainScratch_[i];
+
+            if (portals_[prevPortal].region == portals_[portal].region) {
+                AppendPortalPath(prevPortal, portal, pathScratch_);
+            }
+            else {
+                // stepping over the border
+                pathScratch_.push_back(portals_[portal].tile);
+            }
+        }
+
+        auto lastTile = portals_[chainScratch_.back()].tile;
+        SearchRegion(toRegion, lastTile);
+        AppendRegionPath(lastTile, toTile, pathScratch_);
+    }
+
+    ResetRegionSearch();
+
+    if (outPath) {
+        outPath->clear();
+
+        for (auto tile : pathScratch_) {
+            outPath->emplace_back(tile % w_, tile / w_);
+        }
+    }
+
+    return true;
+}
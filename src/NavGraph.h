@@ -0,0 +1,128 @@
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "Types.h"
+
+class WorldArea;
+
+/**
+* A path across an area that something is chasing a target along, for WorldArea::GetChaseDirection(); each
+* chaser keeps its own. It's found again once the target moves away from where it was found to, or the chaser
+* strays from it.
+*/
+struct ChasePath
+{
+    std::vector<sf::Vector2f> waypoints;
+    std::size_t nextWaypoint;
+
+    sf::Vector2f goal;
+    bool hasGoal;
+
+    ChasePath() :
+        nextWaypoint(0),
+        hasGoal(false)
+    { }
+};
+
+/**
+* Abstract graph of an area's rooms & passages for long range pathfinding (HPA*-style).
+* Each region (a room, or a straight piece of passage, as the generator placed them) is a node cluster;
+* portals are the walkable tiles bordering another region, linked to the portals of their own region by
+* the length of the path between them, & to their neighbour across the border by a step. Searches run
+* A* over the portals only, then fill in the tiles between them from paths cached per pair of portals.
+* Built from the tiles as they were when constructed; it doesn't follow later tile changes.
+* Searches reuse scratch space, so it must only be searched from one thread at a time.
+*/
+class NavGraph
+{
+public:
+    static const u32 NoRegion = 0xffffffff;
+
+private:
+    static const u32 NoPortal = 0xffffffff;
+    static const u32 Unreached = 0xffffffff;
+
+    struct Portal
+    {
+        u32 tile;
+        u32 region;
+
+        // other portals & the steps to walk to them; those in the same region, & those across the border
+        std::vector<std::pair<u32, u32>> links;
+    };
+
+    struct TileRegion
+    {
+        u32 region;
+        u32 regionIndex; // where the tile is within its region, for the search buffers
+    };
+
+    u32 w_, h_;
+
+    // region of each walkable tile, keyed by y * w_ + x; only the walkable tiles are in it, so it's as big
+    // as the floor rather than the area
+    std::unordered_map<u32, TileRegion> tileRegions_;
+    std::vector<std::vector<u32>> regionPortals_;
+    std::vector<Portal> portals_;
+
+    // breadth-first search within a region, by the reached tiles' indices within it, so they're only as
+    // big as the biggest region; the tiles it reached (& their indices) are in the order reached, so that
+    // only they need resetting for the next one
+    mutable std::vector<u32> tileDist_;
+    mutable std::vector<u32> tileParent_;
+    mutable std::vector<std::pair<u32, u32>> tileReached_;
+
+    // A* over the portals
+    mutable std::vector<u32> portalCost_;
+    mutable std::vector<u32> portalParent_;
+    mutable std::vector<u32> portalGoalCost_;
+    mutable std::vector<u32> portalTouched_;
+    mutable std::vector<std::pair<u32, u32>> openScratch_;
+    mutable std::vector<u32> chainScratch_;
+    mutable std::vector<u32> pathScratch_;
+
+    // tiles walked between pairs of portals in the same region (excluding the first), found as needed. emptied
+    // once it holds MaxCachedPortalPaths, so that a long session of searches can't grow it without limit
+    static const std::size_t MaxCachedPortalPaths = 4096;
+
+    mutable std::unordered_map<u64, std::vector<u32>> portalPathCache_;
+
+    const TileRegion* FindTileRegion(u32 tile) const;
+
+    void SearchRegion(u32 region, u32 fromTile) const;
+    u32 GetRegionSearchDistance(u32 tile) const;
+    void ResetRegionSearch() const;
+    void AppendRegionPath(u32 fromTile, u32 toTile, std::vector<u32>& outTiles) const;
+    void AppendPortalPath(u32 fromPortal, u32 toPortal, std::vector<u32>& outTiles) const;
+
+    u32 GetHeuristic(u32 tile, u32 goalTile) const;
+
+public:
+    /**
+    * Builds the graph from the walkable tiles of area. genRegions holds which room or passage the generator
+    * placed each tile as, keyed by y * width + x (tiles missing from it are in none); these are split further
+    * where they aren't connected.
+    */
+    NavGraph(const WorldArea& area, const std::unordered_map<u32, u32>& genRegions);
+    ~NavGraph();
+
+    /**
+    * Finds a path from the tile at fromX, fromY to the one at toX, toY, writing the tiles to walk through
+    * (excluding the first & ending with the last) to outPath. Returns false if there's none.
+    */
+    bool FindPath(u32 fromX, u32 fromY, u32 toX, u32 toY, std::vector<sf::Vector2u>* outPath) const;
+
+    inline u32 GetTileRegion(u32 x, u32 y) const
+    {
+        auto tileRegion = x < w_ && y < h_ ? FindTileRegion(y * w_ + x) : nullptr;
+        return tileRegion ? tileRegion->region : NoRegion;
+    }
+
+    inline std::size_t GetRegionCount() const { return regionPortals_.size(); }
+    inline std::size_t GetPortalCount() const { return portals_.size(); }
+};
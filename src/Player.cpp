@@ -1,5 +1,9 @@
 #include "Player.h"
 
+#include <cassert>
+#include <cmath>
+#include <iterator>
+
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RectangleShape.hpp> // TODO Probably for debug
@@ -13,6 +17,8 @@
 
 PlayerDefaultStartEntity::PlayerDefaultStartEntity()
 {
+    // only a marker; never needs ticking
+    SetDormant(true);
 }
 
 
@@ -86,7 +92,7 @@ void PlayerInventory::GiveItem(Item* item)
 
     if (receivedAmount > 0) {
         Game::Get().AddMessage("You received " + item->GetItemName() + " x " + std::to_string(receivedAmount));
-        GameAssets::Get().pickupSound.play();
+        AudioQueue::Get().Play(GameAssets::Get().pickupSoundBuffer);
     }
     else if (receivedAmount == 0) {
         Game::Get().AddMessage("You cannot carry another " + item->GetItemName() + ".");
@@ -101,6 +107,10 @@ PlayerEntity::PlayerEntity() :
 AliveEntity(),
 useRange_(25.0f),
 targettedUsableEnt_(InvalidId),
+nearbyUsableEntsVersion_(0),
+nearbyUsableEntsValid_(false),
+targettedNearbyUsableIndex_(0),
+targettedUsableEntIsUsable_(false),
 inv_(nullptr),
 nextDir_(PlayerFacingDirection::Down),
 dir_(PlayerFacingDirection::Down),
@@ -109,6 +119,7 @@ useTarget_(false),
 handledDeath_(false)
 {
     SetSize(sf::Vector2f(12.0f, 12.0f));
+    SetCollisionLayer(CollisionLayer::Player);
     InitAnimations();
 }
 
@@ -222,7 +233,7 @@ bool PlayerEntity::PickupItem(Item* item)
         Game::Get().AddMessage("Congratulations - you've found an artefact piece!");
         Game::Get().GetDirector().FoundArtefact(GetAssignedArea());
         item->SetAmount(0);
-        GameAssets::Get().artefactPickupSound.play();
+        AudioQueue::Get().Play(GameAssets::Get().pickup2SoundBuffer);
     }
 
     inv_->GiveItem(item);
@@ -346,6 +357,99 @@ void PlayerEntity::HandleMovement()
 }
 
 
+bool PlayerEntity::UpdateNearbyUsableEntities()
+{
+    auto area = GetAssignedArea();
+    assert(area);
+
+    auto pos = GetCenterPosition();
+    auto cell = sf::Vector2i(static_cast<int>(std::floor(pos.x / BaseTile::TileSize.x)),
+        static_cast<int>(std::floor(pos.y / BaseTile::TileSize.y)));
+
+    if (nearbyUsableEntsValid_ && cell == nearbyUsableEntsCell_ &&
+        area->GetUsableEntitiesVersion() == nearbyUsableEntsVersion_) {
+        return false;
+    }
+
+    // anywhere else in this cell is at most a cell diagonal away from here, so widen
+    // the range by that much to catch everything we could reach before changing cell
+    auto cellDiagonal = std::sqrt(BaseTile::TileSize.x * BaseTile::TileSize.x +
+        BaseTile::TileSize.y * BaseTile::TileSize.y);
+
+    nearbyUsableEnts_.clear();
+    area->GetUsableEntitiesInRange(pos, useRange_ + cellDiagonal, std::back_inserter(nearbyUsableEnts_));
+
+    nearbyUsableEntsCell_ = cell;
+    nearbyUsableEntsVersion_ = area->GetUsableEntitiesVersion();
+    nearbyUsableEntsValid_ = true;
+    return true;
+}
+
+
+bool PlayerEntity::IsUsableTargetStale() const
+{
+    if (targettedUsableEnt_ == InvalidId || !targettedUsableEntIsUsable_) {
+        return !nearbyUsableEnts_.empty();
+    }
+
+    auto& usableInfo = nearbyUsableEnts_[targettedNearbyUsableIndex_];
+    if (usableInfo.ent->IsMarkedForDeletion()) {
+        return true;
+    }
+
+    auto pos = GetCenterPosition();
+    auto usableEntPos = usableInfo.ent->GetCenterPosition();
+    auto distSq = (usableEntPos.x - pos.x) * (usableEntPos.x - pos.x) +
+        (usableEntPos.y - pos.y) * (usableEntPos.y - pos.y);
+
+    return distSq > useRange_ * useRange_ || !usableInfo.usable->IsUsable(GetAssignedId());
+}
+
+
+void PlayerEntity::ChooseUsableTarget()
+{
+    EntityId closestUsableEntId = InvalidId;
+    std::size_t closestUsableEntIndex = 0;
+    bool closestUsableEntIsCurrentlyUsable = false;
+    float closestUsableEntDistSq = useRange_ * useRange_ + 1.0f;
+
+    auto pos = GetCenterPosition();
+
+    for (std::size_t i = 0; i < nearbyUsableEnts_.size(); ++i) {
+        auto& usableInfo = nearbyUsableEnts_[i];
+        if (usableInfo.ent->IsMarkedForDeletion()) {
+            continue;
+        }
+
+        auto usableEntPos = usableInfo.ent->GetCenterPosition();
+        auto distSq = (usableEntPos.x - pos.x) * (usableEntPos.x - pos.x) +
+            (usableEntPos.y - pos.y) * (usableEntPos.y - pos.y);
+
+        if (distSq > useRange_ * useRange_) {
+            continue;
+        }
+
+        bool currentlyUsable = usableInfo.usable->IsUsable(GetAssignedId());
+        bool isCloser = distSq < closestUsableEntDistSq;
+
+        // prioritise PlayerUsables that are currently usable over
+        // those that are currently unusable within the proximity of the player
+        if ((!closestUsableEntIsCurrentlyUsable && isCloser) ||
+            (!closestUsableEntIsCurrentlyUsable && currentlyUsable) ||
+            (closestUsableEntIsCurrentlyUsable && currentlyUsable && isCloser)) {
+            closestUsableEntId = usableInfo.id;
+            closestUsableEntIndex = i;
+            closestUsableEntDistSq = distSq;
+            closestUsableEntIsCurrentlyUsable = currentlyUsable;
+        }
+    }
+
+    targettedUsableEnt_ = closestUsableEntId;
+    targettedNearbyUsableIndex_ = closestUsableEntIndex;
+    targettedUsableEntIsUsable_ = closestUsableEntIsCurrentlyUsable;
+}
+
+
 void PlayerEntity::HandleUseNearbyObjects()
 {
     auto area = GetAssignedArea();
@@ -357,40 +461,21 @@ void PlayerEntity::HandleUseNearbyObjects()
 
     // use target from last tick if use key was pressed
     if (useTarget_ && targettedUsableEnt_ != InvalidId) {
-        auto usableEnt = dynamic_cast<PlayerUsable*>(area->GetEntity(targettedUsableEnt_));
+        auto targettedEnt = area->GetEntity(targettedUsableEnt_);
+        auto usableEnt = dynamic_cast<PlayerUsable*>(targettedEnt);
 
         if (usableEnt && usableEnt->IsUsable(GetAssignedId())) {
+            // using an ent may change it, so give it a tick
+            targettedEnt->Wake();
             usableEnt->Use(GetAssignedId());
         }
     }
 
     // update target
-    auto entsInRange = area->GetWorldEntitiesInRange(GetCenterPosition(), useRange_);
-
-    EntityId closestUsableEntId = InvalidId;
-    bool closestUsableEntIsCurrentlyUsable = false;
-    float closestUsableEntDistSq = useRange_ * useRange_ + 1.0f;
-
-    for (auto& eInfo : entsInRange) {
-        auto usableEnt = dynamic_cast<PlayerUsable*>(area->GetEntity<WorldEntity>(eInfo.first));
-
-        if (usableEnt) {
-            bool currentlyUsable = usableEnt->IsUsable(GetAssignedId());
-            bool isCloser = eInfo.second < closestUsableEntDistSq;
-
-            // prioritise PlayerUsables that are currently usable over
-            // those that are currently unusable within the proximity of the player
-            if ((!closestUsableEntIsCurrentlyUsable && isCloser) ||
-                (!closestUsableEntIsCurrentlyUsable && currentlyUsable) ||
-                (closestUsableEntIsCurrentlyUsable && currentlyUsable && isCloser)) {
-                closestUsableEntId = eInfo.first;
-                closestUsableEntDistSq = eInfo.second;
-                closestUsableEntIsCurrentlyUsable = currentlyUsable;
-            }
-        }
+    if (UpdateNearbyUsableEntities() || IsUsableTargetStale()) {
+        ChooseUsableTarget();
     }
 
-    targettedUsableEnt_ = closestUsableEntId;
     useTarget_ = false;
 }
 
@@ -426,7 +511,7 @@ u32 PlayerEntity::DamageWithoutInvincibility(u32 amount, DamageType source)
     Game::Get().ResetDisplayedQuestion(); // interrupt question interface if it's up
     Game::Get().NotifyPlayerDamaged(amount);
 
-    GameAssets::Get().playerHurtSound.play();
+    AudioQueue::Get().Play(GameAssets::Get().playerHurtSoundBuffer, SoundPriority::High);
     return AliveEntity::Damage(amount, source);
 }
 
@@ -445,7 +530,7 @@ void PlayerEntity::Tick()
         // handle death specific stuff for this
         // death
         if (!handledDeath_) {
-            GameAssets::Get().playerDeathSound.play();
+            AudioQueue::Get().Play(GameAssets::Get().playerDeathSoundBuffer, SoundPriority::High);
             Game::Get().AddMessage("Oh dear - you have been knocked out!", sf::Color(255, 0, 0));
 
             Game::Get().NotifyPlayerDeath();
@@ -474,7 +559,7 @@ void PlayerEntity::Tick()
 }
 
 
-void PlayerEntity::Render(sf::RenderTarget& target)
+void PlayerEntity::Render(CountingRenderTarget& target)
 {
     bool isDead = GetStats() && !GetStats()->IsAlive();
 
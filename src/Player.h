@@ -1,6 +1,11 @@
 #pragma once
 
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
 #include "Entity.h"
+#include "PlayerUsable.h"
 
 #include "Item.h"
 #include "Animation.h"
@@ -16,7 +21,7 @@ public:
     PlayerDefaultStartEntity();
     virtual ~PlayerDefaultStartEntity();
 
-    inline virtual std::string GetName() const { return "PlayerDefaultStartEntity"; }
+    inline virtual const char* GetName() const { return "PlayerDefaultStartEntity"; }
 };
 
 /**
@@ -123,6 +128,20 @@ class PlayerEntity : public AliveEntity
     float useRange_;
     EntityId targettedUsableEnt_;
 
+    // PlayerUsables that could be in use range from anywhere in the tile cell we gathered them from.
+    // only re-gathered when we change cell or the area's PlayerUsables change
+    std::vector<PlayerUsableEntityInfo> nearbyUsableEnts_;
+    sf::Vector2i nearbyUsableEntsCell_;
+    u32 nearbyUsableEntsVersion_;
+    bool nearbyUsableEntsValid_;
+
+    // the target is chosen from those again when they're re-gathered, or if it stops being in range, is
+    // removed or changes whether it's usable. while there's no target (or an unusable one that a usable
+    // ent could beat), the rest of them could come into range as we move within the cell, so it's chosen
+    // again each tick until there's a usable one
+    std::size_t targettedNearbyUsableIndex_;
+    bool targettedUsableEntIsUsable_;
+
     sf::Time invincibilityTime_;
 
     PlayerInventory* inv_;
@@ -150,6 +169,9 @@ class PlayerEntity : public AliveEntity
     void TickMoveAnimations();
 
     void HandleMovement();
+    bool UpdateNearbyUsableEntities();
+    bool IsUsableTargetStale() const;
+    void ChooseUsableTarget();
     void HandleUseNearbyObjects();
 
 public:
@@ -157,7 +179,9 @@ public:
     virtual ~PlayerEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
+
+    inline virtual void OnAssignedToArea() override { nearbyUsableEntsValid_ = false; }
 
     void AddMoveInDirection(PlayerFacingDirection dir);
 
@@ -204,13 +228,18 @@ public:
 
     inline PlayerFacingDirection GetFacingDirection() const { return dir_; }
 
-    inline void SetUseRange(float useRange) { useRange_ = useRange; }
+    inline void SetUseRange(float useRange)
+    {
+        useRange_ = useRange;
+        nearbyUsableEntsValid_ = false;
+    }
+
     inline float GetUseRange() const { return useRange_; }
 
     inline EntityId GetTargettedUsableEntity() const { return targettedUsableEnt_; }
 
     inline virtual std::string GetUnitName() const override { return "Player"; }
 
-    inline virtual std::string GetName() const override { return "PlayerEntity"; }
+    inline virtual const char* GetName() const override { return "PlayerEntity"; }
 };
 
@@ -8,8 +8,13 @@
 */
 class PlayerUsable
 {
+    // WorldArea keeps our index into its list of usable ents, so we can be removed from it quickly
+    friend class WorldArea;
+
+    std::size_t usableIndex_;
+
 public:
-    PlayerUsable() { }
+    PlayerUsable() : usableIndex_(0) { }
     virtual ~PlayerUsable() { }
 
     virtual void Use(EntityId playerId) = 0;
@@ -17,4 +22,14 @@ public:
     virtual bool IsUsable(EntityId playerId) const = 0;
     virtual std::string GetUseText() const = 0;
     virtual std::string GetCannotUseText() const { return std::string(); }
-};
\ No newline at end of file
+};
+
+/**
+* A PlayerUsable ent as indexed by its WorldArea.
+*/
+struct PlayerUsableEntityInfo
+{
+    EntityId id;
+    WorldEntity* ent;
+    PlayerUsable* usable;
+};
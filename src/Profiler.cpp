@@ -0,0 +1,203 @@
+#include "Profiler.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+
+const std::size_t Profiler::MaxZones;
+const std::size_t Profiler::MaxZoneDepth;
+const std::size_t Profiler::RootZone;
+
+thread_local bool Profiler::isOwnerThread_ = false;
+
+
+Profiler::Profiler() :
+zoneCount_(0),
+zoneDepth_(0),
+ownerThreadSet_(false),
+frameCount_(0),
+frameAllocCount_(0),
+frameAllocBytes_(0),
+frameFreeCount_(0),
+lastFrameAllocCount_(0),
+lastFrameAllocBytes_(0),
+lastFrameFreeCount_(0),
+totalAllocCount_(0),
+totalAllocBytes_(0)
+{
+    zones_.fill(ProfilerZoneStats());
+    RegisterZone("(untracked)");
+}
+
+
+Profiler::~Profiler()
+{
+}
+
+
+bool Profiler::IsTrackingAllocations()
+{
+#ifdef UOLEDUGAME_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+std::size_t Profiler::RegisterZone(const char* name)
+{
+    for (std::size_t i = 0; i < zoneCount_; ++i) {
+        if (std::strcmp(zones_[i].name, name) == 0) {
+            return i;
+        }
+    }
+
+    if (zoneCount_ >= MaxZones) {
+        assert(!"Profiler has run out of zones!");
+        return RootZone;
+    }
+
+    zones_[zoneCount_] = ProfilerZoneStats();
+    zones_[zoneCount_].name = name;
+    return zoneCount_++;
+}
+
+
+void Profiler::PushZone(std::size_t zoneIndex)
+{
+    if (!IsOwnerThread()) {
+        return;
+    }
+
+    // deeper zones than we can track are folded into their parent
+    if (zoneDepth_ < MaxZoneDepth) {
+        zoneStack_[zoneDepth_] = zoneIndex;
+    }
+
+    ++zoneDepth_;
+}
+
+
+void Profiler::PopZone(u64 elapsedMicroseconds)
+{
+    if (!IsOwnerThread() || zoneDepth_ == 0) {
+        return;
+    }
+
+    --zoneDepth_;
+
+    if (zoneDepth_ < MaxZoneDepth) {
+        auto& zone = zones_[zoneStack_[zoneDepth_]];
+
+        ++zone.calls;
+        zone.totalMicroseconds += elapsedMicroseconds;
+        zone.frameMicroseconds += elapsedMicroseconds;
+    }
+}
+
+
+void Profiler::RecordAllocation(std::size_t size)
+{
+    // the audio thread & friends also allocate; only attribute the game thread
+    if (!IsOwnerThread()) {
+        return;
+    }
+
+    auto& zone = zones_[zoneDepth_ > 0 ? zoneStack_[std::min(zoneDepth_, MaxZoneDepth) - 1] : RootZone];
+
+    ++zone.frameAllocCount;
+    zone.frameAllocBytes += size;
+    ++zone.totalAllocCount;
+    zone.totalAllocBytes += size;
+
+    ++frameAllocCount_;
+    frameAllocBytes_ += size;
+    ++totalAllocCount_;
+    totalAllocBytes_ += size;
+}
+
+
+void Profiler::RecordFree()
+{
+    if (!IsOwnerThread()) {
+        return;
+    }
+
+    ++frameFreeCount_;
+}
+
+
+void Profiler::BeginFrame()
+{
+    if (!isOwnerThread_ && !ownerThreadSet_.exchange(true)) {
+        isOwnerThread_ = true;
+    }
+
+    frameAllocCount_ = 0;
+    frameAllocBytes_ = 0;
+    frameFreeCount_ = 0;
+
+    for (std::size_t i = 0; i < zoneCount_; ++i) {
+        zones_[i].frameMicroseconds = 0;
+        zones_[i].frameAllocCount = 0;
+        zones_[i].frameAllocBytes = 0;
+    }
+}
+
+
+void Profiler::EndFrame()
+{
+    assert(zoneDepth_ == 0 && "Unbalanced profiler zones at end of frame!");
+
+    lastFrameAllocCount_ = frameAllocCount_;
+    lastFrameAllocBytes_ = frameAllocBytes_;
+    lastFrameFreeCount_ = frameFreeCount_;
+
+    for (std::size_t i = 0; i < zoneCount_; ++i) {
+        zones_[i].lastFrameMicroseconds = zones_[i].frameMicroseconds;
+        zones_[i].lastFrameAllocCount = zones_[i].frameAllocCount;
+        zones_[i].lastFrameAllocBytes = zones_[i].frameAllocBytes;
+    }
+
+    ++frameCount_;
+}
+
+
+void Profiler::PrintTopAllocatingZones(std::size_t maxZones) const
+{
+    if (!IsTrackingAllocations()) {
+        std::cout << "Profiler - allocation tracking not compiled in (enable UOLEDUGAME_TRACK_ALLOCATIONS)\n";
+        return;
+    }
+
+    std::array<std::size_t, MaxZones> sortedZones;
+    for (std::size_t i = 0; i < zoneCount_; ++i) {
+        sortedZones[i] = i;
+    }
+
+    std::sort(sortedZones.begin(), sortedZones.begin() + zoneCount_, [this](std::size_t a, std::size_t b) {
+        return zones_[a].totalAllocCount > zones_[b].totalAllocCount;
+    });
+
+    auto frames = std::max<u64>(1, frameCount_);
+
+    std::cout << "Profiler - " << totalAllocCount_ << " allocation(s) (" << totalAllocBytes_ << " bytes) over "
+        << frameCount_ << " frame(s); last frame: " << lastFrameAllocCount_ << " allocation(s), "
+        << lastFrameAllocBytes_ << " bytes, " << lastFrameFreeCount_ << " free(s)\n";
+
+    for (std::size_t i = 0; i < std::min(maxZones, zoneCount_); ++i) {
+        auto& zone = zones_[sortedZones[i]];
+
+        if (zone.totalAllocCount == 0) {
+            break;
+        }
+
+        std::cout << "\t" << zone.name << ": "
+            << static_cast<double>(zone.totalAllocCount) / frames << " allocs/frame, "
+            << static_cast<double>(zone.totalAllocBytes) / frames << " bytes/frame (last frame: "
+            << zone.lastFrameAllocCount << " allocs, " << zone.lastFrameAllocBytes << " bytes)\n";
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "Types.h"
+#include "CountingRenderTarget.h"
+
+/**
+* Timing and allocation counters for a single profiler zone.
+* Allocations are attributed to the innermost active zone only.
+*/
+struct ProfilerZoneStats
+{
+    const char* name;
+
+    u64 calls;
+    u64 totalMicroseconds;
+    u64 totalAllocCount;
+    u64 totalAllocBytes;
+
+    u64 frameMicroseconds;
+    u64 frameAllocCount;
+    u64 frameAllocBytes;
+
+    u64 lastFrameMicroseconds;
+    u64 lastFrameAllocCount;
+    u64 lastFrameAllocBytes;
+};
+
+/**
+* Simple frame profiler made up of named zones. Zones are pushed & popped on
+* the main thread by ProfilerZoneScope (see PROFILE_ZONE).
+*
+* NOTE: the profiler must never allocate itself, as the optional
+* allocation hook (see AllocationHook.cpp) reports into it.
+*/
+class Profiler
+{
+    static const std::size_t MaxZones = 64;
+    static const std::size_t MaxZoneDepth = 32;
+
+    std::array<ProfilerZoneStats, MaxZones> zones_;
+    std::size_t zoneCount_;
+
+    std::array<std::size_t, MaxZoneDepth> zoneStack_;
+    std::size_t zoneDepth_;
+
+    // the allocation hook asks from every thread, so the owner is claimed once & remembered per thread
+    std::atomic<bool> ownerThreadSet_;
+    static thread_local bool isOwnerThread_;
+
+    u64 frameCount_;
+
+    u64 frameAllocCount_;
+    u64 frameAllocBytes_;
+    u64 frameFreeCount_;
+
+    u64 lastFrameAllocCount_;
+    u64 lastFrameAllocBytes_;
+    u64 lastFrameFreeCount_;
+
+    u64 totalAllocCount_;
+    u64 totalAllocBytes_;
+
+    RenderFrameStats lastFrameRenderStats_;
+
+    Profiler();
+    ~Profiler();
+
+    inline bool IsOwnerThread() const { return isOwnerThread_; }
+
+public:
+    /**
+    * Index of the zone that collects allocations made outside of any other zone.
+    */
+    static const std::size_t RootZone = 0;
+
+    static inline Profiler& Get()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    /**
+    * Returns true if the global operator new/delete hook was compiled in
+    * (UOLEDUGAME_TRACK_ALLOCATIONS).
+    */
+    static bool IsTrackingAllocations();
+
+    /**
+    * Returns the index of the zone with the given name, registering it if needed.
+    * The name must outlive the profiler (use string literals).
+    */
+    std::size_t RegisterZone(const char* name);
+
+    void PushZone(std::size_t zoneIndex);
+    void PopZone(u64 elapsedMicroseconds);
+
+    void RecordAllocation(std::size_t size);
+    void RecordFree();
+
+    void BeginFrame();
+    void EndFrame();
+
+    inline void SetLastFrameRenderStats(const RenderFrameStats& stats) { lastFrameRenderStats_ = stats; }
+    inline const RenderFrameStats& GetLastFrameRenderStats() const { return lastFrameRenderStats_; }
+
+    inline u64 GetFrameCount() const { return frameCount_; }
+
+    inline u64 GetLastFrameAllocCount() const { return lastFrameAllocCount_; }
+    inline u64 GetLastFrameAllocBytes() const { return lastFrameAllocBytes_; }
+    inline u64 GetLastFrameFreeCount() const { return lastFrameFreeCount_; }
+
+    inline std::size_t GetZoneCount() const { return zoneCount_; }
+    inline const ProfilerZoneStats& GetZone(std::size_t zoneIndex) const { return zones_[zoneIndex]; }
+
+    /**
+    * Prints the zones that allocated the most over all profiled frames.
+    */
+    void PrintTopAllocatingZones(std::size_t maxZones = 10) const;
+};
+
+/**
+* Pushes a profiler zone for the lifetime of this object.
+*/
+class ProfilerZoneScope
+{
+    std::chrono::high_resolution_clock::time_point startTime_;
+
+public:
+    explicit ProfilerZoneScope(std::size_t zoneIndex) :
+    startTime_(std::chrono::high_resolution_clock::now())
+    {
+        Profiler::Get().PushZone(zoneIndex);
+    }
+
+    ~ProfilerZoneScope()
+    {
+        Profiler::Get().PopZone(static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - startTime_).count()));
+    }
+};
+
+/**
+* Profiles the rest of the enclosing scope as the zone with the given name.
+* Only one may be used per scope.
+*/
+#define PROFILE_ZONE(name) \
+    static const std::size_t profileZoneIndex_ = Profiler::Get().RegisterZone(name); \
+    ProfilerZoneScope profileZoneScope_(profileZoneIndex_)
@@ -11,7 +11,7 @@ ProjectileEntity::ProjectileEntity(ProjectileType projectileType, const sf::Vect
 UnitEntity(),
 projectileType_(projectileType),
 damage_(0),
-timeLeft_(sf::seconds(2.0f))
+lifetime_(sf::seconds(2.0f))
 {
     SetSize(sf::Vector2f(14.0f, 14.0f));
 
@@ -25,12 +25,12 @@ timeLeft_(sf::seconds(2.0f))
 
     case ProjectileType::EffectOrb:
         speed = 80.0f;
-        timeLeft_ = sf::seconds(6.0f);
+        lifetime_ = sf::seconds(6.0f);
         break;
 
     case ProjectileType::EnemySmoke:
         speed = 150.0f;
-        timeLeft_ = sf::seconds(3.0f);
+        lifetime_ = sf::seconds(3.0f);
         break;
 
     case ProjectileType::EnemyMagicWave:
@@ -42,7 +42,12 @@ timeLeft_(sf::seconds(2.0f))
         break;
     }
 
-    velo_ = dir * speed;
+    velo_ = ScaleWorldVector(WorldVectorFromFloat(dir), speed);
+
+    // effect orbs are just for show
+    if (projectileType_ != ProjectileType::EffectOrb) {
+        SetCollisionLayer(CollisionLayer::Projectile);
+    }
 
     SetupAnimations();
 }
@@ -132,91 +137,95 @@ void ProjectileEntity::Tick()
         return;
     }
 
-    // tile collision
-    bool isCollision = false;
-    
-    if (CollidesWithTiles()) {
-        isCollision = !MoveWithCollision(velo_ * Game::FrameTimeStep.asSeconds());
-    }
-    else {
-        Move(velo_ * Game::FrameTimeStep.asSeconds());
-    }
+    // sweep the whole move, so fast projectiles can't skip past walls or thin ents
+    auto move = WorldVectorToFloat(ScaleWorldVector(velo_, Game::FrameTimeStep.asSeconds()));
+    auto moveTime = CollidesWithTiles() ? area->SweepRectThroughTiles(GetRectangle(), move) : 1.0f;
+    bool isCollision = moveTime < 1.0f;
+
+    // ent collision; the ent we'd run into first, if before (or as) we hit a wall
+    AliveEntity* hitEnt = nullptr;
 
-    // ent collision
     if (projectileType_ != ProjectileType::EffectOrb) {
-        std::vector<EntityId> hitEntIds;
+        const CollisionRectInfo sweep(GetRectangle(), move);
+        auto sweepRegion = Collision::GetAABBSweepBroadphaseRegion(CollisionRectInfo(GetRectangle(), move * moveTime));
+
+        auto tryHitEnt = [&](AliveEntity* ent) {
+            if (ent->GetStats() && ent->GetStats()->IsAlive()) {
+                auto hitTime = Collision::RectangleSweepFirstContact(sweep, CollisionRectInfo(ent->GetRectangle()), nullptr);
+
+                if (hitTime < 1.0f && hitTime <= moveTime && (!hitEnt || hitTime < moveTime)) {
+                    hitEnt = ent;
+                    moveTime = hitTime;
+                }
+            }
+        };
 
         if (IsPlayerProjectile()) {
-            hitEntIds = area->GetAllWorldEntsInRectangle<Enemy>(GetRectangle());
+            area->ForEachContactInRect<Enemy>(*this, sweepRegion, tryHitEnt);
         }
         else {
-            hitEntIds = area->GetAllWorldEntsInRectangle<PlayerEntity>(GetRectangle());
+            area->ForEachContactInRect<PlayerEntity>(*this, sweepRegion, tryHitEnt);
         }
+    }
 
-        for (auto eId : hitEntIds) {
-            auto hitEnt = area->GetEntity<AliveEntity>(eId);
-            assert(hitEnt);
-
-            if (hitEnt->GetStats() && hitEnt->GetStats()->IsAlive()) {
-                // projectile type effect
-                isCollision = true;
-
-                // hit type
-                switch (projectileType_) {
-                case ProjectileType::PlayerMagicWave:
-                case ProjectileType::EnemyMagicWave:
-                case ProjectileType::EnemyMagicFlame:
-                    hitEnt->Attack(GetDamage(), DamageType::Magic);
-                    break;
-
-                case ProjectileType::EnemySmoke:
-                    hitEnt->Attack(GetDamage(), DamageType::Other);
-                    break;
-                }
+    Move(move * moveTime);
 
-                // hit effect
-                DamageEffectType effectType;
+    if (hitEnt) {
+        // projectile type effect
+        isCollision = true;
+
+        // hit type
+        switch (projectileType_) {
+        case ProjectileType::PlayerMagicWave:
+        case ProjectileType::EnemyMagicWave:
+        case ProjectileType::EnemyMagicFlame:
+            hitEnt->Attack(GetDamage(), DamageType::Magic);
+            break;
 
-                switch (projectileType_) {
-                case ProjectileType::PlayerMagicWave:
-                    effectType = DamageEffectType::PlayerWave;
-                    break;
+        case ProjectileType::EnemySmoke:
+            hitEnt->Attack(GetDamage(), DamageType::Other);
+            break;
+        }
 
-                case ProjectileType::EnemyMagicWave:
-                    effectType = DamageEffectType::EnemyWave;
-                    break;
+        // hit effect
+        DamageEffectType effectType;
 
-                case ProjectileType::EnemyMagicFlame:
-                    effectType = DamageEffectType::EnemyMagicFlame;
-                    break;
+        switch (projectileType_) {
+        case ProjectileType::PlayerMagicWave:
+            effectType = DamageEffectType::PlayerWave;
+            break;
 
-                case ProjectileType::EnemySmoke:
-                    effectType = DamageEffectType::EnemySmoke;
-                    break;
-                }
+        case ProjectileType::EnemyMagicWave:
+            effectType = DamageEffectType::EnemyWave;
+            break;
 
-                auto effectEnt = hitEnt->GetAssignedArea()->GetEntity<DamageEffectEntity>(
-                    hitEnt->GetAssignedArea()->EmplaceEntity<DamageEffectEntity>(effectType, sf::seconds(0.5f)));
-                effectEnt->SetCenterPosition(hitEnt->GetCenterPosition());
+        case ProjectileType::EnemyMagicFlame:
+            effectType = DamageEffectType::EnemyMagicFlame;
+            break;
 
-                // push ent
-                hitEnt->MoveWithCollision(0.05f * velo_);
-                break;
-            }
+        case ProjectileType::EnemySmoke:
+            effectType = DamageEffectType::EnemySmoke;
+            break;
         }
+
+        auto effectEnt = hitEnt->GetAssignedArea()->GetEntity<DamageEffectEntity>(
+            hitEnt->GetAssignedArea()->EmplaceEntity<DamageEffectEntity>(effectType, sf::seconds(0.5f)));
+        effectEnt->SetCenterPosition(hitEnt->GetCenterPosition());
+
+        // push ent
+        hitEnt->MoveWithCollision(ScaleWorldVector(velo_, 0.05f));
     }
 
-    // remove on collision or expire
-    if (isCollision || timeLeft_ <= sf::Time::Zero) {
+    // remove on collision (expiry is handled by our lifetime timer)
+    if (isCollision) {
         MarkForDeletion();
     }
 
-    timeLeft_ -= Game::FrameTimeStep;
     anim_.Tick();
 }
 
 
-void ProjectileEntity::Render(sf::RenderTarget& target)
+void ProjectileEntity::Render(CountingRenderTarget& target)
 {
     auto area = GetAssignedArea();
 
@@ -228,7 +237,7 @@ void ProjectileEntity::Render(sf::RenderTarget& target)
         switch (projectileType_) {
         case ProjectileType::PlayerMagicWave:
         case ProjectileType::EnemyMagicWave:
-            projectileSprite->setRotation(Helper::RadiansToDegrees(atan2f(velo_.y, velo_.x)));
+            projectileSprite->setRotation(Helper::RadiansToDegrees(atan2f(GetVelocity().y, GetVelocity().x)));
             break;
 
         case ProjectileType::EnemyMagicFlame:
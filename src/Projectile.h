@@ -24,20 +24,24 @@ class ProjectileEntity : public UnitEntity
     Animation anim_;
 
     u32 damage_;
-    sf::Vector2f velo_;
-    sf::Time timeLeft_;
+    WorldVector velo_;
+    sf::Time lifetime_;
 
     void SetupAnimations();
 
+protected:
+    inline virtual void OnAssignedToArea() override { StartTimer(0, lifetime_); }
+    inline virtual void OnTimer(u32 tag) override { MarkForDeletion(); }
+
 public:
     ProjectileEntity(ProjectileType projectileType, const sf::Vector2f& dir);
     virtual ~ProjectileEntity();
 
     virtual void Tick() override;
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
-    inline void SetVelocity(const sf::Vector2f& velo) { velo_ = velo; }
-    inline sf::Vector2f GetVelocity() const { return velo_; }
+    inline void SetVelocity(const sf::Vector2f& velo) { velo_ = WorldVectorFromFloat(velo); }
+    inline sf::Vector2f GetVelocity() const { return WorldVectorToFloat(velo_); }
 
     inline ProjectileType GetProjectileType() const { return projectileType_; }
 
@@ -47,8 +51,8 @@ public:
     inline void SetDamage(u32 damage) { damage_ = damage; }
     inline u32 GetDamage() const { return damage_; }
 
-    inline sf::Time GetTimeLeft() const { return timeLeft_; }
+    inline sf::Time GetLifetime() const { return lifetime_; }
 
     inline virtual std::string GetUnitName() const override { return "Projectile"; }
-    inline virtual std::string GetName() const override { return "ProjectileEntity"; }
+    inline virtual const char* GetName() const override { return "ProjectileEntity"; }
 };
@@ -10,6 +10,7 @@ StairEntity::StairEntity() :
 UnitEntity()
 {
     SetSize(BaseTile::TileSize);
+    SetDormant(true);
 }
 
 
@@ -44,7 +45,7 @@ UpStairEntity::~UpStairEntity()
 }
 
 
-void UpStairEntity::Render(sf::RenderTarget& target)
+void UpStairEntity::Render(CountingRenderTarget& target)
 {
     sf::Sprite stairSprite(GameAssets::Get().stairsSpriteSheet);
 
@@ -130,7 +131,7 @@ DownStairEntity::~DownStairEntity()
 }
 
 
-void DownStairEntity::Render(sf::RenderTarget& target)
+void DownStairEntity::Render(CountingRenderTarget& target)
 {
     sf::Sprite stairSprite(GameAssets::Get().stairsSpriteSheet);
 
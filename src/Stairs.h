@@ -39,7 +39,7 @@ public:
     UpStairEntity();
     virtual ~UpStairEntity();
 
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     virtual bool IsUsable(EntityId playerId) const override;
     virtual void Use(EntityId playerId) override;
@@ -49,7 +49,7 @@ public:
     inline virtual StairEntityType GetStairType() const override { return StairEntityType::Up; }
     inline virtual std::string GetUnitName() const override { return "Staircase to .."; }
 
-    inline virtual std::string GetName() const override { return "UpStairEntity"; }
+    inline virtual const char* GetName() const override { return "UpStairEntity"; }
 };
 
 /**
@@ -63,7 +63,7 @@ public:
     DownStairEntity(const std::string& destinationFsNodeName = std::string());
     virtual ~DownStairEntity();
 
-    virtual void Render(sf::RenderTarget& target) override;
+    virtual void Render(CountingRenderTarget& target) override;
 
     inline std::string GetDestinationFsNodeName() const { return destinationFsNodeName_; }
 
@@ -75,5 +75,5 @@ public:
     inline virtual StairEntityType GetStairType() const override { return StairEntityType::Down; }
     inline virtual std::string GetUnitName() const override { return "Staircase to " + destinationFsNodeName_; }
 
-    inline virtual std::string GetName() const override { return "DownStairEntity"; }
+    inline virtual const char* GetName() const override { return "DownStairEntity"; }
 };
@@ -0,0 +1,283 @@
+#include "StressScene.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "Game.h"
+#include "Helper.h"
+#include "Log.h"
+#include "World.h"
+#include "Player.h"
+#include "Enemy.h"
+
+
+StressScene::StressScene() :
+area_(nullptr),
+guardianVolleys_(false),
+volleysFired_(0),
+rampTargetEnemies_(0),
+rampTargetStreams_(0),
+rampStepsLeft_(0),
+rampFramesPerStep_(0),
+rampFramesLeft_(0)
+{
+}
+
+
+StressScene::~StressScene()
+{
+}
+
+
+bool StressScene::FindSpawnPosition(WorldArea& area, const sf::Vector2f& center, const sf::Vector2f& size,
+    sf::Vector2f& outPos) const
+{
+    for (int tryCount = 0; tryCount < 100; ++tryCount) {
+        auto pos = center + sf::Vector2f(Helper::GenerateRandomReal(-400.0f, 400.0f),
+            Helper::GenerateRandomReal(-400.0f, 400.0f));
+
+        if (pos.x >= 0.0f && pos.y >= 0.0f && area.CheckEntRectangleWalkable(sf::FloatRect(pos, size))) {
+            outPos = pos;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+u32 StressScene::SpawnEnemies(WorldArea& area, u32 count, const sf::Vector2f& center)
+{
+    static const std::array<EnemyType, 9> enemyTypes = {
+        EnemyType::SkeletonBasic,
+        EnemyType::GreenBlobBasic,
+        EnemyType::BlueBlobBasic,
+        EnemyType::RedBlobBasic,
+        EnemyType::PinkBlobBasic,
+        EnemyType::GhostBasic,
+        EnemyType::MagicFlameBasic,
+        EnemyType::AncientWizardBasic,
+        EnemyType::DarkWizardBasic
+    };
+
+    area_ = &area;
+    u32 spawned = 0;
+
+    for (u32 i = 0; i < count; ++i) {
+        auto enemyType = enemyTypes[(spawnedEnemies_.size() + i) % enemyTypes.size()];
+
+        auto enemyId = area.EmplaceEntity<BasicEnemy>(enemyType);
+        auto enemy = area.GetEntity<BasicEnemy>(enemyId);
+        assert(enemy);
+
+        sf::Vector2f spawnPos;
+        if (!FindSpawnPosition(area, center, enemy->GetSize(), spawnPos)) {
+            area.RemoveEntity(enemyId);
+            continue;
+        }
+
+        enemy->SetPosition(spawnPos);
+        spawnedEnemies_.emplace_back(enemyId);
+        ++spawned;
+    }
+
+    return spawned;
+}
+
+
+u32 StressScene::AddProjectileStreams(WorldArea& area, u32 count, const sf::Vector2f& center)
+{
+    static const std::array<ProjectileType, 4> streamTypes = {
+        ProjectileType::EnemyMagicWave,
+        ProjectileType::EnemyMagicFlame,
+        ProjectileType::EnemySmoke,
+        ProjectileType::EffectOrb
+    };
+
+    area_ = &area;
+    u32 added = 0;
+
+    for (u32 i = 0; i < count; ++i) {
+        ProjectileStream stream;
+
+        if (!FindSpawnPosition(area, center, sf::Vector2f(18.0f, 18.0f), stream.origin)) {
+            continue;
+        }
+
+        stream.angleRads = Helper::GenerateRandomReal(0.0f, 2.0f * PI);
+        stream.angularSpeedRads = Helper::GenerateRandomReal(-2.0f * PI, 2.0f * PI);
+        stream.type = streamTypes[streams_.size() % streamTypes.size()];
+        stream.fireTimeLeft = sf::Time::Zero;
+
+        streams_.emplace_back(stream);
+        ++added;
+    }
+
+    return added;
+}
+
+
+void StressScene::SetGuardianVolleys(WorldArea& area, bool enabled)
+{
+    area_ = &area;
+    guardianVolleys_ = enabled;
+    volleyTimeLeft_ = sf::Time::Zero;
+}
+
+
+void StressScene::StartRamp(u32 enemyCount, u32 streamCount, bool guardianVolleys, u32 steps, u32 framesPerStep)
+{
+    rampTargetEnemies_ = enemyCount;
+    rampTargetStreams_ = streamCount;
+    rampStepsLeft_ = std::max<u32>(1, steps);
+    rampFramesPerStep_ = framesPerStep;
+    rampFramesLeft_ = 0;
+
+    guardianVolleys_ = guardianVolleys;
+    volleyTimeLeft_ = sf::Time::Zero;
+}
+
+
+void StressScene::TickRamp(WorldArea& area, const sf::Vector2f& center)
+{
+    if (rampStepsLeft_ == 0 || rampFramesLeft_-- > 0) {
+        return;
+    }
+
+    // spawn an even share of what's left of the target each step
+    auto enemiesLeft = rampTargetEnemies_ - std::min(rampTargetEnemies_, GetSpawnedEnemyCount());
+    auto streamsLeft = rampTargetStreams_ - std::min(rampTargetStreams_, GetProjectileStreamCount());
+
+    SpawnEnemies(area, enemiesLeft / rampStepsLeft_, center);
+    AddProjectileStreams(area, streamsLeft / rampStepsLeft_, center);
+
+    --rampStepsLeft_;
+    rampFramesLeft_ = rampFramesPerStep_;
+
+    LOG_INFO("StressScene - ramp step: {} enemies, {} projectile streams", GetSpawnedEnemyCount(),
+        GetProjectileStreamCount());
+}
+
+
+void StressScene::Clear(WorldArea* currentArea)
+{
+    // only touch the area's ents if it's still the one we spawned into
+    if (currentArea && currentArea == area_) {
+        for (auto enemyId : spawnedEnemies_) {
+            auto enemy = currentArea->GetEntity(enemyId);
+            if (enemy) {
+                enemy->MarkForDeletion();
+            }
+        }
+    }
+
+    area_ = nullptr;
+    spawnedEnemies_.clear();
+    streams_.clear();
+    guardianVolleys_ = false;
+    rampStepsLeft_ = 0;
+}
+
+
+void StressScene::Tick(WorldArea* area, PlayerEntity* player)
+{
+    if (!area || !player) {
+        return;
+    }
+
+    // changing areas ends the scene
+    if (area_ && area_ != area) {
+        area_ = nullptr;
+        spawnedEnemies_.clear();
+        streams_.clear();
+        guardianVolleys_ = false;
+        rampStepsLeft_ = 0;
+        return;
+    }
+
+    if (IsRamping()) {
+        area_ = area;
+        TickRamp(*area, player->GetCenterPosition());
+    }
+
+    if (!IsActive()) {
+        return;
+    }
+
+    // keep the player alive so the load stays the same for the whole run
+    player->SetInvincibility(sf::seconds(1.0f));
+
+    // forget enemies that have been killed
+    spawnedEnemies_.erase(std::remove_if(spawnedEnemies_.begin(), spawnedEnemies_.end(),
+        [area](EntityId id) { return !area->GetEntity(id); }), spawnedEnemies_.end());
+
+    for (auto& stream : streams_) {
+        stream.angleRads += stream.angularSpeedRads * Game::FrameTimeStep.asSeconds();
+
+        if ((stream.fireTimeLeft -= Game::FrameTimeStep) <= sf::Time::Zero) {
+            sf::Vector2f projectileDir(cosf(stream.angleRads), sinf(stream.angleRads));
+
+            auto projectile = area->GetEntity<ProjectileEntity>(
+                area->EmplaceEntity<ProjectileEntity>(stream.type, projectileDir));
+            assert(projectile);
+
+            projectile->SetCenterPosition(stream.origin);
+            projectile->SetDamage(1);
+
+            stream.fireTimeLeft = sf::seconds(0.1f);
+        }
+    }
+
+    if (guardianVolleys_ && (volleyTimeLeft_ -= Game::FrameTimeStep) <= sf::Time::Zero) {
+        // alternate between the smoke form's volley & the death burst, near the player like the boss
+        auto volleyCenter = player->GetCenterPosition() + Helper::GenerateRandomReal(75.0f, 110.0f) *
+            Helper::GetUnitVector(sf::Vector2f(Helper::GenerateRandomReal(-1.0f, 1.0f), Helper::GenerateRandomReal(-1.0f, 1.0f)));
+
+        if (volleysFired_++ % 2 == 0) {
+            DungeonGuardian::FireSmokeVolley(*area, volleyCenter, 1, 1);
+        }
+        else {
+            DungeonGuardian::FireDeathOrbBurst(*area, volleyCenter);
+        }
+
+        volleyTimeLeft_ = sf::seconds(0.5f);
+    }
+}
+
+
+void StressScene::RecordFrame(std::size_t entCount, u64 tickMicroseconds, u64 renderMicroseconds)
+{
+    if (!IsActive()) {
+        return;
+    }
+
+    auto& sample = samples_[std::make_pair(GetSpawnedEnemyCount(), GetProjectileStreamCount())];
+
+    ++sample.frames;
+    sample.totalEnts += entCount;
+    sample.totalTickMicroseconds += tickMicroseconds;
+    sample.totalRenderMicroseconds += renderMicroseconds;
+}
+
+
+void StressScene::PrintReport() const
+{
+    if (samples_.empty()) {
+        LOG_INFO("StressScene - no frames recorded");
+        return;
+    }
+
+    LOG_INFO("StressScene - tick/render scaling (averages per frame):");
+
+    for (auto& sampleEntry : samples_) {
+        auto& sample = sampleEntry.second;
+        auto avgEnts = static_cast<double>(sample.totalEnts) / sample.frames;
+        auto avgTickMs = sample.totalTickMicroseconds / 1000.0 / sample.frames;
+        auto avgRenderMs = sample.totalRenderMicroseconds / 1000.0 / sample.frames;
+
+        LOG_INFO("\t{} enemies, {} streams: {} ents, tick {} ms, render {} ms, {} us tick/ent ({} frames)",
+            sampleEntry.first.first, sampleEntry.first.second, avgEnts, avgTickMs, avgRenderMs,
+            avgEnts > 0.0 ? (avgTickMs * 1000.0 / avgEnts) : 0.0, sample.frames);
+    }
+}
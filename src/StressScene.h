@@ -0,0 +1,119 @@
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "Types.h"
+#include "Entity.h"
+#include "Projectile.h"
+
+class WorldArea;
+class PlayerEntity;
+
+/**
+* Debug helper that puts the current area under entity load by spawning enemies,
+* projectile streams & Dungeon Guardian volleys, recording how the tick & render
+* times scale with the amount spawned.
+*/
+class StressScene
+{
+    struct ProjectileStream
+    {
+        sf::Vector2f origin;
+        float angleRads;
+        float angularSpeedRads;
+        ProjectileType type;
+        sf::Time fireTimeLeft;
+    };
+
+    struct ScaleSample
+    {
+        u64 frames;
+        u64 totalEnts;
+        u64 totalTickMicroseconds;
+        u64 totalRenderMicroseconds;
+
+        ScaleSample() :
+            frames(0),
+            totalEnts(0),
+            totalTickMicroseconds(0),
+            totalRenderMicroseconds(0)
+        { }
+    };
+
+    WorldArea* area_;
+
+    std::vector<EntityId> spawnedEnemies_;
+    std::vector<ProjectileStream> streams_;
+
+    bool guardianVolleys_;
+    sf::Time volleyTimeLeft_;
+    u32 volleysFired_;
+
+    // ramped spawning used by headless runs
+    u32 rampTargetEnemies_;
+    u32 rampTargetStreams_;
+    u32 rampStepsLeft_;
+    u32 rampFramesPerStep_;
+    u32 rampFramesLeft_;
+
+    // samples keyed by (spawned enemies, projectile streams)
+    std::map<std::pair<u32, u32>, ScaleSample> samples_;
+
+    bool FindSpawnPosition(WorldArea& area, const sf::Vector2f& center, const sf::Vector2f& size,
+        sf::Vector2f& outPos) const;
+
+    void TickRamp(WorldArea& area, const sf::Vector2f& center);
+
+public:
+    StressScene();
+    ~StressScene();
+
+    /**
+    * Spawns count BasicEnemies of mixed types around center.
+    * Returns the amount actually spawned.
+    */
+    u32 SpawnEnemies(WorldArea& area, u32 count, const sf::Vector2f& center);
+
+    /**
+    * Adds count rotating projectile emitters around center.
+    */
+    u32 AddProjectileStreams(WorldArea& area, u32 count, const sf::Vector2f& center);
+
+    void SetGuardianVolleys(WorldArea& area, bool enabled);
+    inline bool IsFiringGuardianVolleys() const { return guardianVolleys_; }
+
+    /**
+    * Spawns up to the given amounts in the given number of even steps, waiting
+    * framesPerStep frames between each, so a single run samples several loads.
+    */
+    void StartRamp(u32 enemyCount, u32 streamCount, bool guardianVolleys, u32 steps, u32 framesPerStep);
+    inline bool IsRamping() const { return rampStepsLeft_ > 0; }
+
+    /**
+    * Removes everything spawned into currentArea & stops all emitters.
+    * Samples are kept for the report.
+    */
+    void Clear(WorldArea* currentArea);
+
+    void Tick(WorldArea* area, PlayerEntity* player);
+
+    /**
+    * Records the timings of the last frame against the current load.
+    */
+    void RecordFrame(std::size_t entCount, u64 tickMicroseconds, u64 renderMicroseconds);
+
+    void PrintReport() const;
+
+    inline bool IsActive() const
+    {
+        return area_ && (!spawnedEnemies_.empty() || !streams_.empty() || guardianVolleys_ || IsRamping());
+    }
+
+    inline u32 GetSpawnedEnemyCount() const { return static_cast<u32>(spawnedEnemies_.size()); }
+    inline u32 GetProjectileStreamCount() const { return static_cast<u32>(streams_.size()); }
+};
@@ -32,7 +32,7 @@ GenericTile::~GenericTile()
 }
 
 
-void GenericTile::Render(sf::RenderTarget& target, const sf::Vector2f& pos)
+void GenericTile::Render(CountingRenderTarget& target, const sf::Vector2f& pos)
 {
     if (Game::Get().IsInMapMode()) {
         // not rendering walls while in map mode
@@ -2,7 +2,7 @@
 
 #include <string>
 
-#include <SFML/Graphics/RenderTarget.hpp>
+#include "CountingRenderTarget.h"
 
 /**
 * Represents the base class of a tile inside of the game world.
@@ -16,7 +16,7 @@ public:
 	virtual ~BaseTile();
 
 	virtual void Tick() = 0;
-	virtual void Render(sf::RenderTarget& target, const sf::Vector2f& pos) = 0;
+	virtual void Render(CountingRenderTarget& target, const sf::Vector2f& pos) = 0;
 
 	virtual std::string GetName() const = 0;
 	virtual bool IsWalkable() const = 0;
@@ -52,7 +52,7 @@ public:
 	virtual ~GenericTile();
 
 	inline virtual void Tick() override { }
-	virtual void Render(sf::RenderTarget& target, const sf::Vector2f& pos) override;
+	virtual void Render(CountingRenderTarget& target, const sf::Vector2f& pos) override;
 
 	inline virtual GenericTileType GetType() const { return type_; }
 
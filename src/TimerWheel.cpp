@@ -0,0 +1,84 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+
+const u32 TimerWheel::Level0Bits;
+const u32 TimerWheel::LevelBits;
+const u32 TimerWheel::Level0Size;
+const u32 TimerWheel::LevelSize;
+const u32 TimerWheel::Level1Shift;
+const u32 TimerWheel::Level2Shift;
+const u64 TimerWheel::MaxDelayTicks;
+
+
+TimerWheel::TimerWheel() :
+currentTick_(0),
+pendingCount_(0)
+{
+}
+
+
+TimerWheel::~TimerWheel()
+{
+}
+
+
+void TimerWheel::Insert(const Timer& timer)
+{
+    auto delay = timer.expiryTick - currentTick_;
+
+    if (delay < Level0Size) {
+        level0_[timer.expiryTick & (Level0Size - 1)].emplace_back(timer);
+    }
+    else if (delay < (static_cast<u64>(1) << Level2Shift)) {
+        level1_[(timer.expiryTick >> Level1Shift) & (LevelSize - 1)].emplace_back(timer);
+    }
+    else if (delay <= MaxDelayTicks) {
+        level2_[(timer.expiryTick >> Level2Shift) & (LevelSize - 1)].emplace_back(timer);
+    }
+    else {
+        // too far out for the wheel; park it in the last level 2 slot to be re-inserted once that cascades
+        level2_[((currentTick_ >> Level2Shift) - 1) & (LevelSize - 1)].emplace_back(timer);
+    }
+}
+
+
+void TimerWheel::Cascade(std::vector<Timer>& slot)
+{
+    // re-insert into the finer levels now that they're closer
+    cascadeScratch_.swap(slot);
+
+    for (auto& timer : cascadeScratch_) {
+        Insert(timer);
+    }
+
+    cascadeScratch_.clear();
+}
+
+
+void TimerWheel::Schedule(EntityId entId, u32 tag, u64 delayTicks)
+{
+    Insert(Timer{currentTick_ + std::max<u64>(1, delayTicks), entId, tag});
+    ++pendingCount_;
+}
+
+
+void TimerWheel::Advance(std::vector<Timer>& outExpired)
+{
+    ++currentTick_;
+
+    if ((currentTick_ & (Level0Size - 1)) == 0) {
+        if ((currentTick_ & ((static_cast<u64>(1) << Level2Shift) - 1)) == 0) {
+            Cascade(level2_[(currentTick_ >> Level2Shift) & (LevelSize - 1)]);
+        }
+
+        Cascade(level1_[(currentTick_ >> Level1Shift) & (LevelSize - 1)]);
+    }
+
+    auto& slot = level0_[currentTick_ & (Level0Size - 1)];
+    pendingCount_ -= slot.size();
+
+    outExpired.insert(outExpired.end(), slot.begin(), slot.end());
+    slot.clear();
+}
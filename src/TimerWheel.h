@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Types.h"
+#include "Entity.h"
+
+/**
+* Hierarchical timing wheel of entity timers, keyed on tick number.
+* Scheduling & expiring are O(1) (amortised); pending timers cost nothing per tick
+* other than the occasional cascade into a finer level.
+*/
+class TimerWheel
+{
+public:
+    struct Timer
+    {
+        u64 expiryTick;
+        EntityId entId;
+        u32 tag;
+    };
+
+private:
+    static const u32 Level0Bits = 8;
+    static const u32 LevelBits = 6;
+    static const u32 Level0Size = 1 << Level0Bits;
+    static const u32 LevelSize = 1 << LevelBits;
+
+    // level 0 is per-tick, level 1 covers 256 ticks per slot & level 2 covers 16384 ticks per slot
+    static const u32 Level1Shift = Level0Bits;
+    static const u32 Level2Shift = Level0Bits + LevelBits;
+    static const u64 MaxDelayTicks = (static_cast<u64>(1) << (Level2Shift + LevelBits)) - 1;
+
+    std::array<std::vector<Timer>, Level0Size> level0_;
+    std::array<std::vector<Timer>, LevelSize> level1_;
+    std::array<std::vector<Timer>, LevelSize> level2_;
+
+    u64 currentTick_;
+    std::size_t pendingCount_;
+
+    std::vector<Timer> cascadeScratch_;
+
+    void Insert(const Timer& timer);
+    void Cascade(std::vector<Timer>& slot);
+
+public:
+    TimerWheel();
+    ~TimerWheel();
+
+    /**
+    * Schedules a timer to expire delayTicks after the current tick (at least 1).
+    */
+    void Schedule(EntityId entId, u32 tag, u64 delayTicks);
+
+    /**
+    * Moves to the next tick & appends the timers that expire on it to outExpired.
+    */
+    void Advance(std::vector<Timer>& outExpired);
+
+    inline u64 GetCurrentTick() const { return currentTick_; }
+    inline std::size_t GetPendingCount() const { return pendingCount_; }
+};
@@ -1,7 +1,10 @@
 #include "World.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <limits>
 
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
@@ -10,16 +13,66 @@
 #include "Game.h"
 #include "DungeonGen.h"
 #include "Player.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+
+
+const float WorldArea::UsableCellSize = 64.0f;
+const float WorldArea::SimLodNearDistance = 320.0f;
+const float WorldArea::SimLodFarDistance = 960.0f;
+const float WorldArea::SimLodNearMargin = 64.0f;
+const u32 WorldArea::SimLodMidInterval;
+const std::size_t WorldArea::PrepareTickGrainSize;
+const std::size_t WorldArea::PrepareTickMinParallelCount;
+const u32 WorldArea::TileChunkShift;
+const u32 WorldArea::TileChunkSize;
+const u8 WorldArea::MaxTileClearance;
+const std::size_t WorldArea::MaxLocalClearanceUpdates;
+const std::size_t WorldArea::CollisionLayerCount;
+const float WorldArea::CollisionBoundsMargin = 16.0f;
+const float WorldArea::EnemySeparationSpeed = 30.0f;
+const float WorldArea::ChasePathRepathDistance = 48.0f;
+const float WorldArea::ChasePathWaypointReachedDistance = 4.0f;
+const u16 WorldArea::FlowFieldRadius;
+const u32 WorldArea::FlowFieldWindowSize;
+const u16 WorldArea::FlowFieldUnreached;
+const u32 WorldArea::DefaultThinkInterval;
+const u64 WorldArea::DefaultThinkBudgetMicroseconds;
 
 
 WorldArea::WorldArea(const GameFilesystemNode* relatedNode, u32 w, u32 h) :
 relatedNode_(relatedNode),
-tiles_(w * h),
 w_(w),
 h_(h),
-nextEntId_(0)
+tileChunksW_((w + TileChunkSize - 1) >> TileChunkShift),
+tileChunksH_((h + TileChunkSize - 1) >> TileChunkShift),
+tileChunks_(tileChunksW_ * tileChunksH_),
+clearanceNeedsRebuild_(true),
+walkableTilesDirty_(true),
+nextEntId_(0),
+usableEntsVersion_(0),
+usableCellsVersion_(0),
+usableCellsValid_(false),
+hasSimLodFocus_(false),
+simLodSkippedCount_(0),
+tickingInBackground_(false),
+thinkInterval_(DefaultThinkInterval),
+thinkBudgetMicroseconds_(DefaultThinkBudgetMicroseconds),
+thinkCount_(0),
+deferredThinkCount_(0),
+collisionLayerMasks_(),
+collisionPhase_(0),
+enemySeparation_(true),
+flowFieldDirty_(true),
+queryDepth_(0)
 {
     renderView_.setCenter(sf::Vector2f(w_ * BaseTile::TileSize.x, h_ * BaseTile::TileSize.y) * 0.5f);
+
+    SetLayersCollide(CollisionLayer::Player, CollisionLayer::Enemy, true);
+    SetLayersCollide(CollisionLayer::Player, CollisionLayer::Projectile, true);
+    SetLayersCollide(CollisionLayer::Player, CollisionLayer::Pickup, true);
+    SetLayersCollide(CollisionLayer::Enemy, CollisionLayer::Enemy, true);
+    SetLayersCollide(CollisionLayer::Enemy, CollisionLayer::Projectile, true);
 }
 
 
@@ -43,12 +96,33 @@ void WorldArea::AddDebugRenderableImpl(std::unique_ptr<sf::Drawable> drawable, c
 }
 
 
+std::unique_ptr<BaseTile>& WorldArea::GetOrCreateTileElement(u32 x, u32 y)
+{
+    auto& chunk = tileChunks_[GetTileChunkIndex(x, y)];
+
+    if (!chunk) {
+        // value-initialized, so the clearance starts out as 0 like it was while unallocated
+        chunk = std::make_unique<TileChunk>();
+        chunk->index = GetTileChunkIndex(x, y);
+        allocatedTileChunks_.emplace_back(chunk.get());
+    }
+
+    return chunk->tiles[GetTileIndexInChunk(x, y)];
+}
+
+
 void WorldArea::ClearTiles()
 {
-	std::cout << "Clearing all tiles from area...\n";
-	for (auto& tile : tiles_) {
-		tile.reset();
+	LOG_DEBUG("Clearing all tiles from area...");
+	for (auto& chunk : tileChunks_) {
+		chunk.reset();
 	}
+
+    allocatedTileChunks_.clear();
+    clearanceDirtyTiles_.clear();
+    clearanceNeedsRebuild_ = true;
+    walkableTilesDirty_ = true;
+    flowFieldDirty_ = true;
 }
 
 
@@ -58,11 +132,15 @@ BaseTile* WorldArea::SetTile(u32 x, u32 y, std::unique_ptr<BaseTile>&& tile)
 		return nullptr;
 	}
 
-    auto& targetTile = tiles_[GetTileIndex(x, y)];
-	if (tile) {
-		targetTile = std::move(tile);
+	if (!tile) {
+        // nothing to write, so don't allocate a chunk for it
+		return GetTile(x, y);
 	}
 
+    auto& targetTile = GetOrCreateTileElement(x, y);
+    targetTile = std::move(tile);
+    MarkTileClearanceDirty(x, y);
+
 	return targetTile.get();
 }
 
@@ -73,16 +151,19 @@ BaseTile* WorldArea::PlaceTile(u32 x, u32 y, std::unique_ptr<BaseTile>&& tile)
         return nullptr;
     }
 
-    auto& targetTile = tiles_[GetTileIndex(x, y)];
-    if (targetTile) {
+    if (GetTile(x, y)) {
         // do not replace a tile that already exists here (unlike SetTile())
         return nullptr;
     }
 
-    if (tile) {
-        targetTile = std::move(tile);
+    if (!tile) {
+        return nullptr;
     }
 
+    auto& targetTile = GetOrCreateTileElement(x, y);
+    targetTile = std::move(tile);
+    MarkTileClearanceDirty(x, y);
+
     return targetTile.get();
 }
 
@@ -93,9 +174,10 @@ bool WorldArea::RemoveTile(u32 x, u32 y)
 		return false;
 	}
 
-	auto& tile = GetTileElement(x, y);
-	if (tile) {
-		tile.reset();
+	auto tile = FindTileElement(x, y);
+	if (tile && *tile) {
+		tile->reset();
+		MarkTileClearanceDirty(x, y);
 		return true;
 	}
 
@@ -105,6 +187,8 @@ bool WorldArea::RemoveTile(u32 x, u32 y)
 
 void WorldArea::Tick(bool paused)
 {
+    PROFILE_ZONE("WorldArea::Tick");
+
     // tick debug renderables timer
     for (auto it = debugRenderables_.begin(); it != debugRenderables_.end();) {
         auto& renderableInfo = *it;
@@ -121,194 +205,1275 @@ void WorldArea::Tick(bool paused)
 
     // if not paused, tick area
     if (!paused) {
-        // tick tiles
-        for (u32 y = 0; y < h_; ++y) {
-            for (u32 x = 0; x < w_; ++x) {
-                auto& tile = tiles_[GetTileIndex(x, y)];
+        // tick tiles; only allocated chunks can have any
+        for (auto chunk : allocatedTileChunks_) {
+            for (auto& tile : chunk->tiles) {
+                if (tile) {
+                    tile->Tick();
+                }
+            }
+        }
+
+        // bring the clearance field up to date before anything can query it in parallel
+        UpdateTileClearance();
+        UpdateCollisionPairs();
+        UpdateFlowField();
+
+        FireExpiredTimers();
+
+        // tick active ents; ents spawned while ticking get their first tick next frame
+        auto activeCount = activeEnts_.size();
+        UpdateSimLod(activeCount);
+        RunThinks();
+
+        {
+            PROFILE_ZONE("WorldArea::Tick - prepare ents");
+
+            // read phase in parallel; the results only depend on the world as it was before any
+            // ent ticked, so the write phase below sees the same thing whatever the worker count
+            JobSystem::Get().ParallelFor(activeCount, PrepareTickGrainSize, [this](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                    auto ent = activeEnts_[i];
+
+                    if (!ent->IsMarkedForDeletion() && !ent->IsDormant() && !ent->skippedThisTick_) {
+                        ent->PrepareTick();
+                    }
+                }
+            }, PrepareTickMinParallelCount);
+        }
+
+        // write phase, in order
+        for (std::size_t i = 0; i < activeCount; ++i) {
+            auto ent = activeEnts_[i];
+            assert(ent);
+
+            if (!ent->IsMarkedForDeletion() && !ent->IsDormant() && !ent->skippedThisTick_) {
+                ent->Tick();
+            }
+        }
+
+        // drop ents that went dormant or are about to be deleted from the active set
+        activeEnts_.erase(std::remove_if(activeEnts_.begin(), activeEnts_.end(), [](Entity* ent) {
+            if (ent->IsDormant() || ent->IsMarkedForDeletion()) {
+                ent->inActiveSet_ = false;
+                return true;
+            }
+
+            return false;
+        }), activeEnts_.end());
+
+        // remove ents marked for deletion, dropping them from the collision phase before they're freed
+        if (!pendingDeletions_.empty()) {
+            collisionEnts_.erase(std::remove_if(collisionEnts_.begin(), collisionEnts_.end(), [](WorldEntity* ent) {
+                return ent->IsMarkedForDeletion();
+            }), collisionEnts_.end());
+
+            thinkers_.erase(std::remove_if(thinkers_.begin(), thinkers_.end(), [](Entity* ent) {
+                return ent->IsMarkedForDeletion();
+            }), thinkers_.end());
+        }
+
+        for (auto entId : pendingDeletions_) {
+            auto it = ents_.find(entId);
+            if (it == ents_.end()) {
+                continue;
+            }
+
+            auto usableEnt = dynamic_cast<PlayerUsable*>(it->second.get());
+            if (usableEnt && dynamic_cast<WorldEntity*>(it->second.get())) {
+                RemoveUsableEntity(*usableEnt);
+            }
+
+            RemoveEntityFromTypeBucket(*it->second);
+
+            ents_.erase(it);
+        }
+
+        pendingDeletions_.clear();
+    }
+}
+
+
+void WorldArea::SetLayersCollide(CollisionLayer a, CollisionLayer b, bool collide)
+{
+    auto indexA = static_cast<std::size_t>(a);
+    auto indexB = static_cast<std::size_t>(b);
+
+    if (collide) {
+        collisionLayerMasks_[indexA] |= static_cast<u8>(1u << indexB);
+        collisionLayerMasks_[indexB] |= static_cast<u8>(1u << indexA);
+    }
+    else {
+        collisionLayerMasks_[indexA] &= static_cast<u8>(~(1u << indexB));
+        collisionLayerMasks_[indexB] &= static_cast<u8>(~(1u << indexA));
+    }
+}
+
+
+// straight steps first, so they win ties with diagonal ones in GetFlowFieldDirection()
+static const i64 FlowFieldNeighbourOffsets[8][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+};
+
+
+void WorldArea::UpdateFlowField()
+{
+    // the players' tiles are the sources; most ticks they're the same as last time & there's nothing to do
+    flowFieldSourcesScratch_.clear();
+
+    for (auto ent : collisionEnts_) {
+        if (ent->GetCollisionLayer() != CollisionLayer::Player || ent->IsMarkedForDeletion()) {
+            continue;
+        }
+
+        auto center = ent->GetCenterPosition();
+        if (center.x < 0.0f || center.y < 0.0f) {
+            continue;
+        }
+
+        auto x = static_cast<u32>(center.x / BaseTile::TileSize.x);
+        auto y = static_cast<u32>(center.y / BaseTile::TileSize.y);
+
+        if (!IsTileBlockingRay(x, y)) {
+            flowFieldSourcesScratch_.emplace_back(x, y);
+        }
+    }
+
+    std::sort(flowFieldSourcesScratch_.begin(), flowFieldSourcesScratch_.end(),
+        [](const sf::Vector2u& a, const sf::Vector2u& b) { return a.y != b.y ? a.y < b.y : a.x < b.x; });
+    flowFieldSourcesScratch_.erase(std::unique(flowFieldSourcesScratch_.begin(), flowFieldSourcesScratch_.end()),
+        flowFieldSourcesScratch_.end());
+
+    if (!flowFieldDirty_ && flowFieldSourcesScratch_ == flowFieldSources_) {
+        return;
+    }
+
+    PROFILE_ZONE("WorldArea::UpdateFlowField (rebuild)");
+
+    flowFieldSources_.swap(flowFieldSourcesScratch_);
+    flowFieldDirty_ = false;
+
+    const auto windowArea = FlowFieldWindowSize * FlowFieldWindowSize;
+    flowFieldDist_.assign(flowFieldSources_.size() * windowArea, FlowFieldUnreached);
+
+    // the distance to the nearest source is the least of those to each, so each gets a search of its own
+    for (std::size_t i = 0; i < flowFieldSources_.size(); ++i) {
+        auto dist = &flowFieldDist_[i * windowArea];
+
+        // window x, y of 0, 0 is at the tile FlowFieldRadius up & left of the source
+        i64 originX = static_cast<i64>(flowFieldSources_[i].x) - FlowFieldRadius;
+        i64 originY = static_cast<i64>(flowFieldSources_[i].y) - FlowFieldRadius;
+
+        auto sourceIndex = FlowFieldRadius * FlowFieldWindowSize + FlowFieldRadius;
+        dist[sourceIndex] = 0;
+
+        flowFieldReached_.clear();
+        flowFieldReached_.push_back(sourceIndex);
+
+        for (std::size_t head = 0; head < flowFieldReached_.size(); ++head) {
+            auto index = flowFieldReached_[head];
+            auto indexDist = dist[index];
+
+            // also keeps the search within the window
+            if (indexDist >= FlowFieldRadius) {
+                continue;
+            }
+
+            i64 wx = index % FlowFieldWindowSize;
+            i64 wy = index / FlowFieldWindowSize;
+            auto x = originX + wx;
+            auto y = originY + wy;
+
+            for (auto& offset : FlowFieldNeighbourOffsets) {
+                auto nx = x + offset[0];
+                auto ny = y + offset[1];
+
+                // no cutting corners, as nothing following the field could fit through them
+                if (IsTileBlockingRay(nx, ny) ||
+                    (offset[0] != 0 && offset[1] != 0 && (IsTileBlockingRay(nx, y) || IsTileBlockingRay(x, ny)))) {
+                    continue;
+                }
+
+                auto neighbourIndex = static_cast<u32>((wy + offset[1]) * FlowFieldWindowSize + wx + offset[0]);
+
+                if (dist[neighbourIndex] == FlowFieldUnreached) {
+                    dist[neighbourIndex] = indexDist + 1;
+                    flowFieldReached_.push_back(neighbourIndex);
+                }
+            }
+        }
+    }
+}
+
+
+bool WorldArea::FindPath(const sf::Vector2f& from, const sf::Vector2f& to,
+    std::vector<sf::Vector2f>* outWaypoints) const
+{
+    if (!navGraph_ || from.x < 0.0f || from.y < 0.0f || to.x < 0.0f || to.y < 0.0f) {
+        return false;
+    }
+
+    if (!navGraph_->FindPath(static_cast<u32>(from.x / BaseTile::TileSize.x),
+        static_cast<u32>(from.y / BaseTile::TileSize.y),
+        static_cast<u32>(to.x / BaseTile::TileSize.x),
+        static_cast<u32>(to.y / BaseTile::TileSize.y), &pathTilesScratch_)) {
+        return false;
+    }
+
+    if (outWaypoints) {
+        outWaypoints->clear();
+
+        for (auto& tile : pathTilesScratch_) {
+            outWaypoints->emplace_back((tile.x + 0.5f) * BaseTile::TileSize.x, (tile.y + 0.5f) * BaseTile::TileSize.y);
+        }
+    }
+
+    return true;
+}
+
+
+u16 WorldArea::GetFlowFieldDistance(u32 x, u32 y) const
+{
+    auto bestDist = FlowFieldUnreached;
+
+    for (std::size_t i = 0; i < flowFieldSources_.size(); ++i) {
+        // wraps around to out of the window if x, y is up or left of it
+        auto wx = x - flowFieldSources_[i].x + FlowFieldRadius;
+        auto wy = y - flowFieldSources_[i].y + FlowFieldRadius;
+
+        if (wx < FlowFieldWindowSize && wy < FlowFieldWindowSize) {
+            bestDist = std::min(bestDist,
+                flowFieldDist_[i * FlowFieldWindowSize * FlowFieldWindowSize + wy * FlowFieldWindowSize + wx]);
+        }
+    }
+
+    return bestDist;
+}
+
+
+u16 WorldArea::GetFlowFieldDistance(const sf::Vector2f& pos) const
+{
+    if (pos.x < 0.0f || pos.y < 0.0f) {
+        return FlowFieldUnreached;
+    }
+
+    return GetFlowFieldDistance(static_cast<u32>(pos.x / BaseTile::TileSize.x),
+        static_cast<u32>(pos.y / BaseTile::TileSize.y));
+}
+
+
+bool WorldArea::GetFlowFieldDirection(const sf::Vector2f& pos, WorldVector* outDir) const
+{
+    auto dist = GetFlowFieldDistance(pos);
+    if (dist == FlowFieldUnreached || dist == 0) {
+        return false;
+    }
+
+    i64 x = static_cast<i64>(pos.x / BaseTile::TileSize.x);
+    i64 y = static_cast<i64>(pos.y / BaseTile::TileSize.y);
+
+    auto bestDist = dist;
+    i64 bestX = x, bestY = y;
+
+    for (auto& offset : FlowFieldNeighbourOffsets) {
+        auto nx = x + offset[0];
+        auto ny = y + offset[1];
+
+        if (IsTileBlockingRay(nx, ny) ||
+            (offset[0] != 0 && offset[1] != 0 && (IsTileBlockingRay(nx, y) || IsTileBlockingRay(x, ny)))) {
+            continue;
+        }
+
+        auto neighbourDist = GetFlowFieldDistance(static_cast<u32>(nx), static_cast<u32>(ny));
+
+        if (neighbourDist < bestDist) {
+            bestDist = neighbourDist;
+            bestX = nx;
+            bestY = ny;
+        }
+    }
+
+    if (bestDist == dist) {
+        return false;
+    }
+
+    auto target = sf::Vector2f((bestX + 0.5f) * BaseTile::TileSize.x, (bestY + 0.5f) * BaseTile::TileSize.y);
+
+    if (outDir) {
+        *outDir = GetWorldUnitVector(target - pos);
+    }
+
+    return true;
+}
+
+
+WorldVector WorldArea::GetChaseDirection(const sf::Vector2f& from, const sf::Vector2f& to, ChasePath* path) const
+{
+    WorldVector dir;
+
+    if (GetFlowFieldDirection(from, &dir)) {
+        if (path) {
+            path->hasGoal = false;
+        }
+
+        return dir;
+    }
+
+    if (path && navGraph_) {
+        auto getDistanceSq = [](const sf::Vector2f& a, const sf::Vector2f& b) {
+            return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+        };
+
+        // find the path again if the target's moved away from where it was found to, or we've been pushed off it
+        if (!path->hasGoal || getDistanceSq(path->goal, to) > ChasePathRepathDistance * ChasePathRepathDistance ||
+            (path->nextWaypoint < path->waypoints.size() && getDistanceSq(path->waypoints[path->nextWaypoint],
+            from) > ChasePathRepathDistance * ChasePathRepathDistance)) {
+            if (!FindPath(from, to, &path->waypoints)) {
+                path->waypoints.clear();
+            }
+
+            path->nextWaypoint = 0;
+            path->goal = to;
+            path->hasGoal = true;
+        }
+
+        while (path->nextWaypoint < path->waypoints.size() && getDistanceSq(path->waypoints[path->nextWaypoint],
+            from) < ChasePathWaypointReachedDistance * ChasePathWaypointReachedDistance) {
+            ++path->nextWaypoint;
+        }
+
+        if (path->nextWaypoint < path->waypoints.size()) {
+            return GetWorldUnitVector(path->waypoints[path->nextWaypoint] - from);
+        }
+    }
+
+    return GetWorldUnitVector(to - from);
+}
+
+
+void WorldArea::UpdateCollisionPairs()
+{
+    PROFILE_ZONE("WorldArea::UpdateCollisionPairs");
+
+    ++collisionPhase_;
+    collisionPairs_.clear();
+
+    // pad the bounds so that the contacts found stay good for however far ents move during the tick
+    for (auto ent : collisionEnts_) {
+        auto rect = ent->GetRectangle();
+
+        ent->collisionBounds_ = sf::FloatRect(rect.left - CollisionBoundsMargin, rect.top - CollisionBoundsMargin,
+            rect.width + 2.0f * CollisionBoundsMargin, rect.height + 2.0f * CollisionBoundsMargin);
+        ent->contactsCount_ = 0;
+        ent->contactsPhase_ = collisionPhase_;
+    }
+
+    // insertion sort; close to linear as the order barely changes between ticks
+    for (std::size_t i = 1; i < collisionEnts_.size(); ++i) {
+        auto ent = collisionEnts_[i];
+        auto left = ent->collisionBounds_.left;
+        auto j = i;
+
+        for (; j > 0 && collisionEnts_[j - 1]->collisionBounds_.left > left; --j) {
+            collisionEnts_[j] = collisionEnts_[j - 1];
+        }
+
+        collisionEnts_[j] = ent;
+    }
+
+    // sweep along x; only the ents starting before the right of a's bounds can overlap it
+    for (std::size_t i = 0; i < collisionEnts_.size(); ++i) {
+        auto a = collisionEnts_[i];
+        auto& boundsA = a->collisionBounds_;
+        auto rightA = boundsA.left + boundsA.width;
+        auto maskA = collisionLayerMasks_[static_cast<std::size_t>(a->GetCollisionLayer())];
+
+        for (auto j = i + 1; j < collisionEnts_.size() && collisionEnts_[j]->collisionBounds_.left <= rightA; ++j) {
+            auto b = collisionEnts_[j];
+            auto& boundsB = b->collisionBounds_;
+
+            if ((maskA & (1u << static_cast<u32>(b->GetCollisionLayer()))) &&
+                boundsA.top <= boundsB.top + boundsB.height && boundsB.top <= boundsA.top + boundsA.height) {
+                collisionPairs_.emplace_back(a, b);
+                ++a->contactsCount_;
+                ++b->contactsCount_;
+            }
+        }
+    }
+
+    // lay out the contacts of each ent next to each other
+    std::size_t contactsEnd = 0;
+
+    for (auto ent : collisionEnts_) {
+        ent->contactsBegin_ = contactsEnd;
+        contactsEnd += ent->contactsCount_;
+        ent->contactsCount_ = 0;
+    }
+
+    collisionContacts_.resize(contactsEnd);
+
+    for (auto& pair : collisionPairs_) {
+        collisionContacts_[pair.first->contactsBegin_ + pair.first->contactsCount_++] = pair.second;
+        collisionContacts_[pair.second->contactsBegin_ + pair.second->contactsCount_++] = pair.first;
+    }
+
+    if (enemySeparation_) {
+        SeparateEnemies();
+    }
+}
+
+
+void WorldArea::SeparateEnemies()
+{
+    const auto maxPush = EnemySeparationSpeed * Game::FrameTimeStep.asSeconds();
+
+    for (auto& pair : collisionPairs_) {
+        if (pair.first->GetCollisionLayer() != CollisionLayer::Enemy ||
+            pair.second->GetCollisionLayer() != CollisionLayer::Enemy) {
+            continue;
+        }
+
+        // only Enemys are put on the enemy layer
+        auto a = static_cast<AliveEntity*>(pair.first);
+        auto b = static_cast<AliveEntity*>(pair.second);
+
+        if (a->IsMarkedForDeletion() || b->IsMarkedForDeletion() ||
+            !a->GetStats() || !a->GetStats()->IsAlive() || !b->GetStats() || !b->GetStats()->IsAlive()) {
+            continue;
+        }
+
+        sf::FloatRect overlap;
+        if (!a->GetRectangle().intersects(b->GetRectangle(), overlap)) {
+            continue;
+        }
+
+        // push each out by half of the overlap along its shallowest axis, a little at a time.
+        // ents stacked exactly on top of each other are split by id so it's the same every run
+        auto centerA = a->GetCenterPosition();
+        auto centerB = b->GetCenterPosition();
+        sf::Vector2f push;
+
+        if (overlap.width <= overlap.height) {
+            auto aGoesLeft = centerA.x < centerB.x || (centerA.x == centerB.x && a->GetAssignedId() < b->GetAssignedId());
+            push.x = (aGoesLeft ? -1.0f : 1.0f) * std::min(0.5f * overlap.width, maxPush);
+        }
+        else {
+            auto aGoesUp = centerA.y < centerB.y || (centerA.y == centerB.y && a->GetAssignedId() < b->GetAssignedId());
+            push.y = (aGoesUp ? -1.0f : 1.0f) * std::min(0.5f * overlap.height, maxPush);
+        }
+
+        a->MoveWithCollision(push);
+        b->MoveWithCollision(-push);
+    }
+}
+
+
+void WorldArea::TickInBackground()
+{
+    ClearSimLodFocus();
+
+    tickingInBackground_ = true;
+    Tick();
+    tickingInBackground_ = false;
+}
+
+
+void WorldArea::EnrollThinker(Entity& ent)
+{
+    if (ent.thinkEnrolled_) {
+        return;
+    }
+
+    // spread the first think of ents enrolled together over the interval, so they don't all come due at once
+    ent.thinkEnrolled_ = true;
+    ent.lastThoughtAt_ = timers_.GetCurrentTick() + ent.GetAssignedId() % thinkInterval_ - thinkInterval_;
+    thinkers_.emplace_back(&ent);
+}
+
+
+void WorldArea::RunThinks()
+{
+    PROFILE_ZONE("WorldArea::RunThinks");
+
+    auto currentTick = timers_.GetCurrentTick();
+    thinkQueue_.clear();
+
+    for (auto ent : thinkers_) {
+        // nothing to decide for ents that aren't ticking this time around
+        if (ent->IsMarkedForDeletion() || ent->IsDormant() || !ent->inActiveSet_ || ent->skippedThisTick_) {
+            continue;
+        }
+
+        auto waited = currentTick - ent->lastThoughtAt_;
+        if (waited < thinkInterval_) {
+            continue;
+        }
+
+        auto overdue = static_cast<float>(waited - thinkInterval_ + 1);
+        auto distSq = 0.0f;
+
+        sf::Vector2f entPos;
+        float fullRateDistance;
+
+        if (hasSimLodFocus_ && ent->GetSimLodInfo(entPos, fullRateDistance)) {
+            distSq = (entPos.x - simLodFocus_.x) * (entPos.x - simLodFocus_.x) +
+                (entPos.y - simLodFocus_.y) * (entPos.y - simLodFocus_.y);
+        }
+
+        thinkQueue_.emplace_back(distSq / (overdue * overdue), ent);
+    }
+
+    std::sort(thinkQueue_.begin(), thinkQueue_.end(),
+        [](const std::pair<float, Entity*>& a, const std::pair<float, Entity*>& b) {
+        return a.first != b.first ? a.first < b.first : a.second->GetAssignedId() < b.second->GetAssignedId();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::microseconds(thinkBudgetMicroseconds_);
+
+    thinkCount_ = 0;
+    deferredThinkCount_ = 0;
+
+    for (std::size_t i = 0; i < thinkQueue_.size(); ++i) {
+        // always think at least once, so that a slow tick can't stall everything
+        if (i > 0 && thinkBudgetMicroseconds_ > 0 && std::chrono::steady_clock::now() - start >= budget) {
+            deferredThinkCount_ = thinkQueue_.size() - i;
+            break;
+        }
+
+        // an earlier think may have killed this one off
+        auto ent = thinkQueue_[i].second;
+        if (ent->IsMarkedForDeletion()) {
+            continue;
+        }
+
+        ent->lastThoughtAt_ = currentTick;
+        ent->Think();
+        ++thinkCount_;
+    }
+}
+
+
+void WorldArea::UpdateSimLod(std::size_t activeCount)
+{
+    auto currentTick = timers_.GetCurrentTick();
+    simLodSkippedCount_ = 0;
+
+    for (std::size_t i = 0; i < activeCount; ++i) {
+        auto ent = activeEnts_[i];
+        assert(ent);
+
+        u64 steps = 1;
+        bool skip = false;
+
+        sf::Vector2f entPos;
+        float fullRateDistance;
+
+        if (hasSimLodFocus_ && ent->GetSimLodInfo(entPos, fullRateDistance)) {
+            // the margin keeps ents at full rate a bit past where they need to be, so that neither
+            // side moving during a reduced rate tick can carry one into the other's range unnoticed
+            auto nearDistance = std::max(SimLodNearDistance, fullRateDistance + SimLodNearMargin);
+            auto farDistance = std::max(SimLodFarDistance, nearDistance);
+
+            auto distSq = (entPos.x - simLodFocus_.x) * (entPos.x - simLodFocus_.x) +
+                (entPos.y - simLodFocus_.y) * (entPos.y - simLodFocus_.y);
+
+            if (distSq > farDistance * farDistance) {
+                // frozen
+                skip = true;
+            }
+            else if (distSq > nearDistance * nearDistance) {
+                // staggered by id so mid range ents don't all tick on the same frame
+                if ((currentTick + ent->assignedId_) % SimLodMidInterval != 0) {
+                    skip = true;
+                }
+                else {
+                    // time spent frozen isn't caught up on
+                    steps = std::min<u64>(SimLodMidInterval, std::max<u64>(1, currentTick - ent->lastTickedAt_));
+                }
+            }
+        }
+
+        ent->skippedThisTick_ = skip;
+
+        if (skip) {
+            ++simLodSkippedCount_;
+            continue;
+        }
+
+        ent->tickTimeStep_ = Game::FrameTimeStep * static_cast<sf::Int64>(steps);
+        ent->lastTickedAt_ = currentTick;
+    }
+}
+
+
+void WorldArea::RenderVignette(CountingRenderTarget& target)
+{
+    sf::Sprite vignetteSprite(GameAssets::Get().viewVignette);
+    vignetteSprite.setScale(
+        target.getView().getSize().x / vignetteSprite.getTextureRect().width,
+        target.getView().getSize().y / vignetteSprite.getTextureRect().height
+        );
+
+    target.draw(vignetteSprite);
+}
+
+
+void WorldArea::Render(CountingRenderTarget& target, bool renderDebug)
+{
+    PROFILE_ZONE("WorldArea::Render");
+    RenderPassScope tilesPass(target, RenderPass::Tiles);
+    target.setView(renderView_);
+    
+    // calculate the render region for culling
+    // NOTE: culling doesn't take rotation into account - look at the 
+    // seperate axis theorem to implement that if needed
+    sf::FloatRect renderRegion(renderView_.getCenter() - (renderView_.getSize() * 0.5f), renderView_.getSize());
+
+    // render tiles with culling
+    u32 xTileStart = static_cast<u32>(std::max(0.0f, renderRegion.left / BaseTile::TileSize.x));
+    u32 yTileStart = static_cast<u32>(std::max(0.0f, renderRegion.top / BaseTile::TileSize.y));
+    u32 xTileMax = static_cast<u32>(std::ceil((renderRegion.left + renderRegion.width) / BaseTile::TileSize.x));
+    u32 yTileMax = static_cast<u32>(std::ceil((renderRegion.top + renderRegion.height) / BaseTile::TileSize.y));
+
+    xTileMax = std::min(w_, xTileMax);
+    yTileMax = std::min(h_, yTileMax);
+
+	for (u32 y = yTileStart; y < yTileMax; ++y) {
+		for (u32 x = xTileStart; x < xTileMax; ++x) {
+			auto tile = GetTile(x, y);
+
+            if (tile) {
+                sf::Vector2f tileDrawPos(x * BaseTile::TileSize.x, y * BaseTile::TileSize.y);
+                tile->Render(target, tileDrawPos);
+            }
+		}
+	}
+
+    // render ents with culling - keep player on top of all ents
+    target.SetPass(RenderPass::Entities);
+    PlayerEntity* playerEnt = nullptr;
+
+    for (auto& entEntry : ents_) {
+        auto& ent = entEntry.second;
+        assert(ent);
+
+        if (!ent->IsMarkedForDeletion()) {
+            auto worldEnt = dynamic_cast<WorldEntity*>(ent.get());
+
+            if (!worldEnt || renderRegion.intersects(worldEnt->GetRectangle())) {
+                // try cast to PlayerEntity - if it's not a player or WorldEntity then this will
+                // return null
+                auto playerEntCast = dynamic_cast<PlayerEntity*>(worldEnt);
+
+                if (!playerEntCast) {
+                    ent->Render(target);
+                }
+                else {
+                    // this is the player entity, make note of it
+                    // so we can draw the entity on top of the others.
+                    playerEnt = playerEntCast;
+                }
+
+                // if debug, render world ent rect
+                if (renderDebug && worldEnt) {
+                    auto worldEntRectDbg = std::make_unique<sf::RectangleShape>(worldEnt->GetSize());
+                    worldEntRectDbg->setPosition(worldEnt->GetPosition());
+                    worldEntRectDbg->setFillColor(sf::Color(255, 192, 203, 100));
+                    worldEntRectDbg->setOutlineColor(sf::Color(255, 100, 100));
+                    worldEntRectDbg->setOutlineThickness(-1.0f);
+
+                    AddDebugRenderable(std::move(worldEntRectDbg),
+                        std::string("id ") + std::to_string(entEntry.first) + "\n" + worldEnt->GetName());
+                }
+            }
+        }
+    }
+
+    // if we found a player ent, render it now so it is on top of all ents
+    if (playerEnt) {
+        playerEnt->Render(target);
+    }
+
+    // render vignette if not in map mode
+    if (!Game::Get().IsInMapMode()) {
+        Helper::ResetTargetView(target);
+        RenderVignette(target);
+    }
+
+    // render frame ui renderables and clear list when done
+    target.SetPass(RenderPass::FrameUI);
+    target.setView(renderView_);
+    for (auto& drawable : frameUiRenderables_) {
+        assert(drawable);
+        target.draw(*drawable);
+    }
+
+    frameUiRenderables_.clear();
+
+    // render debug renderables if debug mode (w/o culling!)
+    if (renderDebug) {
+        target.SetPass(RenderPass::Debug);
+
+        for (auto& renderableInfo : debugRenderables_) {
+            assert(renderableInfo.drawable);
+            target.draw(*renderableInfo.drawable);
+
+            if (renderableInfo.IsTransformable()) {
+                auto transformable = dynamic_cast<sf::Transformable*>(renderableInfo.drawable.get());
+                assert(transformable);
+
+                sf::Text debugLabel(renderableInfo.labelString, GameAssets::Get().gameFont);
+                debugLabel.setPosition(transformable->getPosition());
+                debugLabel.setScale(0.1f, 0.1f);
+                Helper::RenderTextWithDropShadow(target, debugLabel, sf::Vector2f(0.5f, 0.5f));
+            }
+        }
+    }
+
+    Helper::ResetTargetView(target);
+}
+
+
+BaseTile* WorldArea::GetTile(u32 x, u32 y)
+{
+	if (!IsTileLocationInBounds(x, y)) {
+		return nullptr;
+	}
+
+	auto tile = FindTileElement(x, y);
+	return tile ? tile->get() : nullptr;
+}
+
+
+const BaseTile* WorldArea::GetTile(u32 x, u32 y) const
+{
+    if (!IsTileLocationInBounds(x, y)) {
+        return nullptr;
+    }
+
+    auto tile = FindTileElement(x, y);
+    return tile ? tile->get() : nullptr;
+}
+
+
+bool WorldArea::CheckRectanglePlaceable(u32 topX, u32 topY, u32 w, u32 h) const
+{
+    if (!IsTileLocationInBounds(topX + w, topY + h)) {
+        return false;
+    }
+
+    for (u32 y = topY; y < (topY + h) && y < h_; ++y) {
+        for (u32 x = topX; x < (topX + w) && x < w_; ++x) {
+            if (GetTile(x, y)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+void WorldArea::MarkTileClearanceDirty(u32 x, u32 y)
+{
+    flowFieldDirty_ = true;
+    walkableTilesDirty_ = true;
+
+    if (clearanceNeedsRebuild_) {
+        return;
+    }
+
+    if (clearanceDirtyTiles_.size() >= MaxLocalClearanceUpdates) {
+        // patching this many is slower than starting over
+        clearanceDirtyTiles_.clear();
+        clearanceNeedsRebuild_ = true;
+        return;
+    }
+
+    clearanceDirtyTiles_.emplace_back(x, y);
+}
+
+
+void WorldArea::ComputeTileClearance(u32 boxX, u32 boxY, u32 boxW, u32 boxH,
+    u32 writeX, u32 writeY, u32 writeW, u32 writeH) const
+{
+    clearanceScratch_.resize(boxW * boxH);
+
+    // past the edge of the area counts as unwalkable, but past the edge of the box is ignored; the box must
+    // extend MaxTileClearance tiles past the written region on every side the area does for it to be exact
+    auto getNeighbourClearance = [&](i64 x, i64 y) -> u32 {
+        if (x < 0 || y < 0 || x >= w_ || y >= h_) {
+            return 0;
+        }
+
+        if (x < boxX || y < boxY || x >= boxX + boxW || y >= boxY + boxH) {
+            return MaxTileClearance;
+        }
+
+        return clearanceScratch_[(y - boxY) * boxW + (x - boxX)];
+    };
+
+    // two-pass chamfer transform; each pass relaxes against the neighbours already visited by it
+    for (i64 y = boxY; y < boxY + boxH; ++y) {
+        for (i64 x = boxX; x < boxX + boxW; ++x) {
+            auto tile = GetTile(static_cast<u32>(x), static_cast<u32>(y));
+            u32 clearance = 0;
+
+            if (tile && tile->IsWalkable()) {
+                clearance = MaxTileClearance;
+                clearance = std::min(clearance, getNeighbourClearance(x - 1, y) + 1);
+                clearance = std::min(clearance, getNeighbourClearance(x - 1, y - 1) + 1);
+                clearance = std::min(clearance, getNeighbourClearance(x, y - 1) + 1);
+                clearance = std::min(clearance, getNeighbourClearance(x + 1, y - 1) + 1);
+            }
+
+            clearanceScratch_[(y - boxY) * boxW + (x - boxX)] = static_cast<u8>(clearance);
+        }
+    }
+
+    for (i64 y = boxY + boxH - 1; y >= boxY; --y) {
+        for (i64 x = boxX + boxW - 1; x >= boxX; --x) {
+            auto& clearance = clearanceScratch_[(y - boxY) * boxW + (x - boxX)];
+
+            if (clearance > 0) {
+                u32 newClearance = clearance;
+                newClearance = std::min(newClearance, getNeighbourClearance(x + 1, y) + 1);
+                newClearance = std::min(newClearance, getNeighbourClearance(x + 1, y + 1) + 1);
+                newClearance = std::min(newClearance, getNeighbourClearance(x, y + 1) + 1);
+                newClearance = std::min(newClearance, getNeighbourClearance(x - 1, y + 1) + 1);
+
+                clearance = static_cast<u8>(newClearance);
+            }
+        }
+    }
+
+    // unallocated chunks have no tiles, so theirs stays 0
+    for (u32 y = writeY; y < writeY + writeH; ++y) {
+        for (u32 x = writeX; x < writeX + writeW; ++x) {
+            auto& chunk = tileChunks_[GetTileChunkIndex(x, y)];
+
+            if (chunk) {
+                chunk->clearance[GetTileIndexInChunk(x, y)] = clearanceScratch_[(y - boxY) * boxW + (x - boxX)];
+            }
+        }
+    }
+}
+
+
+void WorldArea::SortClearanceChunks() const
+{
+    clearanceChunkOrder_.assign(allocatedTileChunks_.begin(), allocatedTileChunks_.end());
+    std::sort(clearanceChunkOrder_.begin(), clearanceChunkOrder_.end(), [](const TileChunk* a, const TileChunk* b) {
+        return a->index < b->index;
+    });
+}
+
+
+void WorldArea::RebuildTileClearance() const
+{
+    // the same two-pass chamfer transform as ComputeTileClearance() over the whole area, but visiting only
+    // the allocated chunks; they're walked a row of chunks at a time so that each pass still sees the tiles
+    // in row-major order. the rest read as 0, as they have no tiles
+    SortClearanceChunks();
+
+    for (std::size_t rowBegin = 0; rowBegin < clearanceChunkOrder_.size();) {
+        auto chunkY = clearanceChunkOrder_[rowBegin]->index / tileChunksW_;
+        auto rowEnd = rowBegin + 1;
+
+        while (rowEnd < clearanceChunkOrder_.size() && clearanceChunkOrder_[rowEnd]->index / tileChunksW_ == chunkY) {
+            ++rowEnd;
+        }
+
+        for (u32 inY = 0; inY < TileChunkSize; ++inY) {
+            for (auto i = rowBegin; i < rowEnd; ++i) {
+                auto chunk = clearanceChunkOrder_[i];
+                auto baseX = static_cast<i64>(chunk->index % tileChunksW_) << TileChunkShift;
+                auto y = static_cast<i64>(chunkY << TileChunkShift) + inY;
+
+                for (u32 inX = 0; inX < TileChunkSize; ++inX) {
+                    auto x = baseX + inX;
+                    auto& tile = chunk->tiles[(inY << TileChunkShift) + inX];
+                    u32 clearance = 0;
+
+                    if (x < w_ && y < h_ && tile && tile->IsWalkable()) {
+                        clearance = MaxTileClearance;
+                        clearance = std::min<u32>(clearance, ReadTileClearance(x - 1, y) + 1);
+                        clearance = std::min<u32>(clearance, ReadTileClearance(x - 1, y - 1) + 1);
+                        clearance = std::min<u32>(clearance, ReadTileClearance(x, y - 1) + 1);
+                        clearance = std::min<u32>(clearance, ReadTileClearance(x + 1, y - 1) + 1);
+                    }
+
+                    chunk->clearance[(inY << TileChunkShift) + inX] = static_cast<u8>(clearance);
+                }
+            }
+        }
+
+        rowBegin = rowEnd;
+    }
+
+    for (auto rowEnd = clearanceChunkOrder_.size(); rowEnd > 0;) {
+        auto chunkY = clearanceChunkOrder_[rowEnd - 1]->index / tileChunksW_;
+        auto rowBegin = rowEnd - 1;
+
+        while (rowBegin > 0 && clearanceChunkOrder_[rowBegin - 1]->index / tileChunksW_ == chunkY) {
+            --rowBegin;
+        }
+
+        for (auto inY = TileChunkSize; inY-- > 0;) {
+            for (auto i = rowEnd; i-- > rowBegin;) {
+                auto chunk = clearanceChunkOrder_[i];
+                auto baseX = static_cast<i64>(chunk->index % tileChunksW_) << TileChunkShift;
+                auto y = static_cast<i64>(chunkY << TileChunkShift) + inY;
+
+                for (auto inX = TileChunkSize; inX-- > 0;) {
+                    auto x = baseX + inX;
+                    auto& clearance = chunk->clearance[(inY << TileChunkShift) + inX];
+
+                    if (clearance > 0) {
+                        u32 newClearance = clearance;
+                        newClearance = std::min<u32>(newClearance, ReadTileClearance(x + 1, y) + 1);
+                        newClearance = std::min<u32>(newClearance, ReadTileClearance(x + 1, y + 1) + 1);
+                        newClearance = std::min<u32>(newClearance, ReadTileClearance(x, y + 1) + 1);
+                        newClearance = std::min<u32>(newClearance, ReadTileClearance(x - 1, y + 1) + 1);
+
+                        clearance = static_cast<u8>(newClearance);
+                    }
+                }
+            }
+        }
+
+        rowEnd = rowBegin;
+    }
+}
+
+
+void WorldArea::UpdateTileClearance() const
+{
+    if (clearanceNeedsRebuild_) {
+        PROFILE_ZONE("WorldArea::UpdateTileClearance (rebuild)");
+
+        RebuildTileClearance();
+        clearanceNeedsRebuild_ = false;
+        clearanceDirtyTiles_.clear();
+        return;
+    }
+
+    // a changed tile can only affect the clearance of tiles up to MaxTileClearance away from it, but
+    // working those out needs the tiles up to MaxTileClearance away from *them*
+    const auto writeRadius = static_cast<u32>(MaxTileClearance);
+    const auto boxRadius = 2 * writeRadius;
+
+    for (auto& dirtyTile : clearanceDirtyTiles_) {
+        auto writeX = dirtyTile.x - std::min(dirtyTile.x, writeRadius);
+        auto writeY = dirtyTile.y - std::min(dirtyTile.y, writeRadius);
+        auto writeW = std::min(w_, dirtyTile.x + writeRadius + 1) - writeX;
+        auto writeH = std::min(h_, dirtyTile.y + writeRadius + 1) - writeY;
+
+        auto boxX = dirtyTile.x - std::min(dirtyTile.x, boxRadius);
+        auto boxY = dirtyTile.y - std::min(dirtyTile.y, boxRadius);
+        auto boxW = std::min(w_, dirtyTile.x + boxRadius + 1) - boxX;
+        auto boxH = std::min(h_, dirtyTile.y + boxRadius + 1) - boxY;
+
+        ComputeTileClearance(boxX, boxY, boxW, boxH, writeX, writeY, writeW, writeH);
+    }
+
+    clearanceDirtyTiles_.clear();
+}
+
+
+u8 WorldArea::GetTileClearance(u32 x, u32 y) const
+{
+    if (!IsTileLocationInBounds(x, y)) {
+        return 0;
+    }
+
+    UpdateTileClearance();
+    return ReadTileClearance(x, y);
+}
+
+
+const std::vector<sf::Vector2u>& WorldArea::GetWalkableTiles() const
+{
+    UpdateTileClearance();
+
+    if (walkableTilesDirty_) {
+        PROFILE_ZONE("WorldArea::GetWalkableTiles (rebuild)");
+
+        SortClearanceChunks();
+        walkableTiles_.clear();
+
+        for (auto chunk : clearanceChunkOrder_) {
+            auto baseX = static_cast<u32>(chunk->index % tileChunksW_) << TileChunkShift;
+            auto baseY = static_cast<u32>(chunk->index / tileChunksW_) << TileChunkShift;
+
+            for (u32 i = 0; i < TileChunkSize * TileChunkSize; ++i) {
+                if (chunk->clearance[i] > 0) {
+                    walkableTiles_.emplace_back(baseX + (i & (TileChunkSize - 1)), baseY + (i >> TileChunkShift));
+                }
+            }
+        }
+
+        walkableTilesDirty_ = false;
+    }
+
+    return walkableTiles_;
+}
+
+
+bool WorldArea::FindNearestClearTile(u32 x, u32 y, u8 minClearance, u32 maxRadius, u32* outX, u32* outY) const
+{
+    UpdateTileClearance();
+
+    auto checkTile = [&](i64 tileX, i64 tileY) {
+        if (tileX < 0 || tileY < 0 || tileX >= w_ || tileY >= h_ || ReadTileClearance(tileX, tileY) < minClearance) {
+            return false;
+        }
 
-                if (tile) {
-                    tile->Tick();
-                }
-            }
+        if (outX) {
+            *outX = static_cast<u32>(tileX);
+        }
+        if (outY) {
+            *outY = static_cast<u32>(tileY);
         }
 
-        // tick ents
-        for (auto& entInfo : ents_) {
-            auto& ent = entInfo.second;
-            assert(ent);
+        return true;
+    };
 
-            if (!ent->IsMarkedForDeletion()) {
-                ent->Tick();
+    maxRadius = std::min(maxRadius, std::max(w_, h_));
+
+    for (i64 r = 0; r <= maxRadius; ++r) {
+        // top & bottom rows of the ring, then the sides between them
+        for (i64 i = -r; i <= r; ++i) {
+            if (checkTile(x + i, y - r) || checkTile(x + i, y + r)) {
+                return true;
             }
         }
 
-        // remove ents marked for deletion
-        for (auto it = ents_.begin(); it != ents_.end();) {
-            auto& ent = it->second;
-            assert(ent);
-
-            if (ent->IsMarkedForDeletion()) {
-                it = ents_.erase(it);
-            }
-            else {
-                ++it;
+        for (i64 i = -r + 1; i <= r - 1; ++i) {
+            if (checkTile(x - r, y + i) || checkTile(x + r, y + i)) {
+                return true;
             }
         }
     }
+
+    return false;
 }
 
 
-void WorldArea::RenderVignette(sf::RenderTarget& target)
+bool WorldArea::Raycast(const sf::Vector2f& from, const sf::Vector2f& to, RaycastHit* outHit) const
 {
-    sf::Sprite vignetteSprite(GameAssets::Get().viewVignette);
-    vignetteSprite.setScale(
-        target.getView().getSize().x / vignetteSprite.getTextureRect().width,
-        target.getView().getSize().y / vignetteSprite.getTextureRect().height
-        );
+    UpdateTileClearance();
+
+    // walk the ray in tile space; t is how far along it we are from 0 to 1
+    const auto startX = from.x / BaseTile::TileSize.x;
+    const auto startY = from.y / BaseTile::TileSize.y;
+    const auto dirX = to.x / BaseTile::TileSize.x - startX;
+    const auto dirY = to.y / BaseTile::TileSize.y - startY;
+
+    auto tileX = static_cast<i64>(std::floor(startX));
+    auto tileY = static_cast<i64>(std::floor(startY));
+    const auto endTileX = static_cast<i64>(std::floor(to.x / BaseTile::TileSize.x));
+    const auto endTileY = static_cast<i64>(std::floor(to.y / BaseTile::TileSize.y));
+
+    const i64 stepX = dirX > 0.0f ? 1 : (dirX < 0.0f ? -1 : 0);
+    const i64 stepY = dirY > 0.0f ? 1 : (dirY < 0.0f ? -1 : 0);
+    const auto noCrossing = std::numeric_limits<float>::infinity();
+
+    // t of the next vertical & horizontal tile boundary crossed, & the t between each of them
+    auto nextTX = stepX > 0 ? (tileX + 1 - startX) / dirX : (stepX < 0 ? (tileX - startX) / dirX : noCrossing);
+    auto nextTY = stepY > 0 ? (tileY + 1 - startY) / dirY : (stepY < 0 ? (tileY - startY) / dirY : noCrossing);
+    const auto deltaTX = stepX != 0 ? std::abs(1.0f / dirX) : noCrossing;
+    const auto deltaTY = stepY != 0 ? std::abs(1.0f / dirY) : noCrossing;
+
+    float t = 0.0f;
+    bool hit = false;
+
+    while (true) {
+        if (IsTileBlockingRay(tileX, tileY)) {
+            hit = true;
+            break;
+        }
 
-    target.draw(vignetteSprite);
+        if (tileX == endTileX && tileY == endTileY) {
+            break;
+        }
+
+        if (nextTX < nextTY) {
+            t = nextTX;
+            tileX += stepX;
+            nextTX += deltaTX;
+        }
+        else {
+            t = nextTY;
+            tileY += stepY;
+            nextTY += deltaTY;
+        }
+
+        // also stop once past the end, in case rounding means we never land in its tile exactly
+        if (t > 1.0f) {
+            break;
+        }
+    }
+
+    if (outHit) {
+        outHit->hit = hit;
+        outHit->tileX = tileX;
+        outHit->tileY = tileY;
+        outHit->fraction = hit ? t : 1.0f;
+        outHit->point = hit ? from + (to - from) * t : to;
+    }
+
+    return hit;
 }
 
 
-void WorldArea::Render(sf::RenderTarget& target, bool renderDebug)
+void WorldArea::RaycastBatch(const RaycastQuery* queries, std::size_t count, RaycastHit* outHits) const
 {
-    target.setView(renderView_);
-    
-    // calculate the render region for culling
-    // NOTE: culling doesn't take rotation into account - look at the 
-    // seperate axis theorem to implement that if needed
-    sf::FloatRect renderRegion(renderView_.getCenter() - (renderView_.getSize() * 0.5f), renderView_.getSize());
+    UpdateTileClearance();
 
-    // render tiles with culling
-    u32 xTileStart = static_cast<u32>(std::max(0.0f, renderRegion.left / BaseTile::TileSize.x));
-    u32 yTileStart = static_cast<u32>(std::max(0.0f, renderRegion.top / BaseTile::TileSize.y));
-    u32 xTileMax = static_cast<u32>(std::ceil((renderRegion.left + renderRegion.width) / BaseTile::TileSize.x));
-    u32 yTileMax = static_cast<u32>(std::ceil((renderRegion.top + renderRegion.height) / BaseTile::TileSize.y));
+    // order the rays by the chunk they start in, then by the row of tiles within it
+    static thread_local std::vector<std::pair<u64, std::size_t>> order;
+    order.clear();
 
-    xTileMax = std::min(w_, xTileMax);
-    yTileMax = std::min(h_, yTileMax);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto tileX = static_cast<u32>(std::max(0.0f, std::min(w_ - 1.0f, queries[i].from.x / BaseTile::TileSize.x)));
+        auto tileY = static_cast<u32>(std::max(0.0f, std::min(h_ - 1.0f, queries[i].from.y / BaseTile::TileSize.y)));
 
-	for (u32 y = yTileStart; y < yTileMax; ++y) {
-		for (u32 x = xTileStart; x < xTileMax; ++x) {
-			auto& tile = tiles_[GetTileIndex(x, y)];
+        order.emplace_back((static_cast<u64>(GetTileChunkIndex(tileX, tileY)) << 32) |
+            GetTileIndexInChunk(tileX, tileY), i);
+    }
 
-            if (tile) {
-                sf::Vector2f tileDrawPos(x * BaseTile::TileSize.x, y * BaseTile::TileSize.y);
-                tile->Render(target, tileDrawPos);
-            }
-		}
-	}
+    std::sort(order.begin(), order.end());
 
-    // render ents with culling - keep player on top of all ents
-    PlayerEntity* playerEnt = nullptr;
+    for (auto& entry : order) {
+        auto& query = queries[entry.second];
+        Raycast(query.from, query.to, &outHits[entry.second]);
+    }
+}
 
-    for (auto& entEntry : ents_) {
-        auto& ent = entEntry.second;
-        assert(ent);
 
-        if (!ent->IsMarkedForDeletion()) {
-            auto worldEnt = dynamic_cast<WorldEntity*>(ent.get());
+float WorldArea::SweepRectThroughTiles(const sf::FloatRect& r, const sf::Vector2f& d, sf::Vector2f* outNormal,
+    i64* outTileX, i64* outTileY) const
+{
+    UpdateTileClearance();
 
-            if (!worldEnt || renderRegion.intersects(worldEnt->GetRectangle())) {
-                // try cast to PlayerEntity - if it's not a player or WorldEntity then this will
-                // return null
-                auto playerEntCast = dynamic_cast<PlayerEntity*>(worldEnt);
+    const CollisionRectInfo mover(r, d);
+    float bestTime = 1.0f;
+    sf::Vector2f bestNormal;
+    i64 bestTileX = 0, bestTileY = 0;
 
-                if (!playerEntCast) {
-                    ent->Render(target);
-                }
-                else {
-                    // this is the player entity, make note of it
-                    // so we can draw the entity on top of the others.
-                    playerEnt = playerEntCast;
-                }
+    // march along the axis we're moving furthest on one slab of tiles at a time, checking the tiles the
+    // swept rect covers while it's within each slab; axis 0 is x, axis 1 is y
+    const float pos[2] = { r.left, r.top };
+    const float size[2] = { r.width, r.height };
+    const float disp[2] = { d.x, d.y };
+    const float tileSize[2] = { BaseTile::TileSize.x, BaseTile::TileSize.y };
 
-                // if debug, render world ent rect
-                if (renderDebug && worldEnt) {
-                    auto worldEntRectDbg = std::make_unique<sf::RectangleShape>(worldEnt->GetSize());
-                    worldEntRectDbg->setPosition(worldEnt->GetPosition());
-                    worldEntRectDbg->setFillColor(sf::Color(255, 192, 203, 100));
-                    worldEntRectDbg->setOutlineColor(sf::Color(255, 100, 100));
-                    worldEntRectDbg->setOutlineThickness(-1.0f);
+    const int major = std::abs(d.x) >= std::abs(d.y) ? 0 : 1;
+    const int minor = 1 - major;
 
-                    AddDebugRenderable(std::move(worldEntRectDbg),
-                        std::string("id ") + std::to_string(entEntry.first) + "\n" + worldEnt->GetName());
-                }
-            }
+    auto firstSlab = static_cast<i64>(std::floor(std::min(pos[major], pos[major] + disp[major]) / tileSize[major]));
+    auto lastSlab = static_cast<i64>(std::ceil((std::max(pos[major], pos[major] + disp[major]) + size[major]) /
+        tileSize[major])) - 1;
+
+    const i64 slabStep = disp[major] >= 0.0f ? 1 : -1;
+    const auto slabCount = lastSlab - firstSlab + 1;
+
+    for (i64 i = 0; i < slabCount; ++i) {
+        auto slab = slabStep > 0 ? firstSlab + i : lastSlab - i;
+        auto slabStart = slab * tileSize[major];
+        auto slabEnd = slabStart + tileSize[major];
+
+        // when the rect is within this slab
+        float enterTime = 0.0f, exitTime = 1.0f;
+
+        if (disp[major] != 0.0f) {
+            auto enter = (slabStep > 0 ? slabStart - (pos[major] + size[major]) : slabEnd - pos[major]) / disp[major];
+            auto exit = (slabStep > 0 ? slabEnd - pos[major] : slabStart - (pos[major] + size[major])) / disp[major];
+
+            enterTime = std::max(0.0f, enter);
+            exitTime = std::min(1.0f, exit);
         }
-    }
 
-    // if we found a player ent, render it now so it is on top of all ents
-    if (playerEnt) {
-        playerEnt->Render(target);
-    }
+        // later slabs are only entered later, so they can't be hit any sooner
+        if (enterTime > bestTime) {
+            break;
+        }
 
-    // render vignette if not in map mode
-    if (!Game::Get().IsInMapMode()) {
-        Helper::ResetTargetView(target);
-        RenderVignette(target);
-    }
+        auto minorStart = std::min(pos[minor] + disp[minor] * enterTime, pos[minor] + disp[minor] * exitTime);
+        auto minorEnd = std::max(pos[minor] + disp[minor] * enterTime, pos[minor] + disp[minor] * exitTime) +
+            size[minor];
 
-    // render frame ui renderables and clear list when done
-    target.setView(renderView_);
-    for (auto& drawable : frameUiRenderables_) {
-        assert(drawable);
-        target.draw(*drawable);
-    }
+        auto firstTile = static_cast<i64>(std::floor(minorStart / tileSize[minor]));
+        auto lastTile = static_cast<i64>(std::ceil(minorEnd / tileSize[minor])) - 1;
 
-    frameUiRenderables_.clear();
+        for (auto tile = firstTile; tile <= lastTile; ++tile) {
+            auto tileX = major == 0 ? slab : tile;
+            auto tileY = major == 0 ? tile : slab;
 
-    // render debug renderables if debug mode (w/o culling!)
-    if (renderDebug) {
-        for (auto& renderableInfo : debugRenderables_) {
-            assert(renderableInfo.drawable);
-            target.draw(*renderableInfo.drawable);
+            if (!IsTileBlockingRay(tileX, tileY)) {
+                continue;
+            }
 
-            if (renderableInfo.IsTransformable()) {
-                auto transformable = dynamic_cast<sf::Transformable*>(renderableInfo.drawable.get());
-                assert(transformable);
+            sf::Vector2f normal;
+            auto time = Collision::RectangleSweepFirstContact(mover, CollisionRectInfo(sf::FloatRect(
+                tileX * BaseTile::TileSize.x, tileY * BaseTile::TileSize.y, BaseTile::TileSize.x, BaseTile::TileSize.y)),
+                &normal);
 
-                sf::Text debugLabel(renderableInfo.labelString, GameAssets::Get().gameFont);
-                debugLabel.setPosition(transformable->getPosition());
-                debugLabel.setScale(0.1f, 0.1f);
-                Helper::RenderTextWithDropShadow(target, debugLabel, sf::Vector2f(0.5f, 0.5f));
+            if (time < bestTime) {
+                bestTime = time;
+                bestNormal = normal;
+                bestTileX = tileX;
+                bestTileY = tileY;
             }
         }
     }
 
-    Helper::ResetTargetView(target);
-}
-
-
-BaseTile* WorldArea::GetTile(u32 x, u32 y)
-{
-	if (!IsTileLocationInBounds(x, y)) {
-		return nullptr;
-	}
+    if (outNormal) {
+        *outNormal = bestNormal;
+    }
+    if (outTileX) {
+        *outTileX = bestTileX;
+    }
+    if (outTileY) {
+        *outTileY = bestTileY;
+    }
 
-	return GetTileElement(x, y).get();
+    return bestTime;
 }
 
 
-const BaseTile* WorldArea::GetTile(u32 x, u32 y) const
+bool WorldArea::CheckRectangleWalkable(u32 topX, u32 topY, u32 w, u32 h) const
 {
-    if (!IsTileLocationInBounds(x, y)) {
-        return nullptr;
+    if (!IsTileLocationInBounds(topX, topY)) {
+        return false;
     }
 
-    return GetTileElement(x, y).get();
-}
+    // only the part of the rect inside the area is checked
+    w = std::min(w, w_ - topX);
+    h = std::min(h, h_ - topY);
 
+    if (w == 0 || h == 0) {
+        return true;
+    }
 
-bool WorldArea::CheckRectanglePlaceable(u32 topX, u32 topY, u32 w, u32 h) const
-{
-    if (!IsTileLocationInBounds(topX + w, topY + h)) {
+    // the clearance of the middle tile gives a square of walkable tiles around it; if that covers the rect,
+    // it's walkable, & if it doesn't even cover the largest square that fits in the rect, it isn't
+    auto centerClearance = GetTileClearance(topX + (w - 1) / 2, topY + (h - 1) / 2);
+
+    if (centerClearance >= std::max(w, h) / 2 + 1) {
+        return true;
+    }
+    if (centerClearance <= (std::min(w, h) - 1) / 2) {
         return false;
     }
 
     for (u32 y = topY; y < (topY + h) && y < h_; ++y) {
         for (u32 x = topX; x < (topX + w) && x < w_; ++x) {
-            if (GetTile(x, y)) {
+            auto tile = GetTile(x, y);
+
+            if (!tile || !tile->IsWalkable()) {
                 return false;
             }
         }
@@ -318,23 +1483,73 @@ bool WorldArea::CheckRectanglePlaceable(u32 topX, u32 topY, u32 w, u32 h) const
 }
 
 
-bool WorldArea::CheckRectangleWalkable(u32 topX, u32 topY, u32 w, u32 h) const
+bool WorldArea::TryCollisionRectMoveFixed(const FixedRect& r, const FixedVector2& d, FixedVector2* outEndPos) const
 {
-    if (!IsTileLocationInBounds(topX, topY)) {
-        return false;
-    }
+    const auto tileW = Fixed::FromFloat(BaseTile::TileSize.x);
+    const auto tileH = Fixed::FromFloat(BaseTile::TileSize.y);
 
-    for (u32 y = topY; y < (topY + h) && y < h_; ++y) {
-        for (u32 x = topX; x < (topX + w) && x < w_; ++x) {
-            auto tile = GetTile(x, y);
+    auto endPos = FixedVector2::FromFixed(r.left + d.x, r.top + d.y);
+    bool collided = false;
 
-            if (!tile || !tile->IsWalkable()) {
-                return false;
+    // index along the axis of movement (x if isX, else y) of the nearest blocking tile in the region, or -1.
+    // positive is whether we're moving towards the far end of the axis
+    auto findNearestBlocking = [this, tileW, tileH](Fixed left, Fixed top, Fixed width, Fixed height, bool isX,
+        bool positive) -> i64 {
+        auto tileStartX = std::max<i64>(0, Fixed::FloorDiv(left.raw, tileW.raw));
+        auto tileStartY = std::max<i64>(0, Fixed::FloorDiv(top.raw, tileH.raw));
+        auto tileEndX = std::min<i64>(w_, Fixed::CeilDiv((left + width).raw, tileW.raw));
+        auto tileEndY = std::min<i64>(h_, Fixed::CeilDiv((top + height).raw, tileH.raw));
+
+        auto axisStart = isX ? tileStartX : tileStartY;
+        auto axisEnd = isX ? tileEndX : tileEndY;
+        auto acrossStart = isX ? tileStartY : tileStartX;
+        auto acrossEnd = isX ? tileEndY : tileEndX;
+
+        for (i64 i = 0; i < axisEnd - axisStart; ++i) {
+            auto along = positive ? axisStart + i : axisEnd - i - 1;
+
+            for (auto across = acrossStart; across < acrossEnd; ++across) {
+                auto tile = isX ? GetTile(static_cast<u32>(along), static_cast<u32>(across)) :
+                    GetTile(static_cast<u32>(across), static_cast<u32>(along));
+
+                if (tile && !tile->IsWalkable()) {
+                    return along;
+                }
             }
         }
+
+        return -1;
+    };
+
+    // step in x first
+    auto xPositive = d.x >= Fixed::FromInt(0);
+    auto xTile = xPositive ?
+        findNearestBlocking(r.left + r.width, r.top, d.x, r.height, true, true) :
+        findNearestBlocking(r.left + d.x, r.top, -d.x, r.height, true, false);
+
+    if (xTile >= 0) {
+        endPos.x = xPositive ? Fixed::FromRaw(xTile * tileW.raw) - r.width :
+            Fixed::FromRaw((xTile + 1) * tileW.raw);
+        collided = true;
     }
 
-    return true;
+    // then y, from where we ended up in x
+    auto yPositive = d.y >= Fixed::FromInt(0);
+    auto yTile = yPositive ?
+        findNearestBlocking(endPos.x, r.top + r.height, r.width, d.y, false, true) :
+        findNearestBlocking(endPos.x, r.top + d.y, r.width, -d.y, false, false);
+
+    if (yTile >= 0) {
+        endPos.y = yPositive ? Fixed::FromRaw(yTile * tileH.raw) - r.height :
+            Fixed::FromRaw((yTile + 1) * tileH.raw);
+        collided = true;
+    }
+
+    if (outEndPos) {
+        *outEndPos = endPos;
+    }
+
+    return !collided;
 }
 
 
@@ -496,6 +1711,103 @@ bool WorldArea::TryCollisionRectMove(const sf::FloatRect& r, const sf::Vector2f&
 }
 
 
+void WorldArea::ScheduleTimer(EntityId entId, u32 tag, const sf::Time& delay)
+{
+    timers_.Schedule(entId, tag, static_cast<u64>(std::max(0.0f, std::ceil(delay / Game::FrameTimeStep))));
+}
+
+
+void WorldArea::FireExpiredTimers()
+{
+    expiredTimers_.clear();
+    timers_.Advance(expiredTimers_);
+
+    // timers of ents that have since been removed are just dropped
+    for (auto& timer : expiredTimers_) {
+        auto ent = GetEntity(timer.entId);
+
+        if (!ent) {
+            continue;
+        }
+
+        if (timer.tag == Entity::WakeTimerTag) {
+            ent->Wake();
+        }
+        else {
+            ent->OnTimer(timer.tag);
+        }
+    }
+}
+
+
+void WorldArea::RemoveUsableEntity(PlayerUsable& usable)
+{
+    // swap the last one into its place
+    auto index = usable.usableIndex_;
+    assert(index < usableEnts_.size() && usableEnts_[index].usable == &usable);
+
+    usableEnts_[index] = usableEnts_.back();
+    usableEnts_[index].usable->usableIndex_ = index;
+    usableEnts_.pop_back();
+    ++usableEntsVersion_;
+}
+
+
+void WorldArea::UpdateUsableCells() const
+{
+    if (usableCellsValid_ && usableCellsVersion_ == usableEntsVersion_) {
+        return;
+    }
+
+    // keep the cells' buffers around for the next rebuild
+    for (auto& cell : usableCells_) {
+        cell.second.clear();
+    }
+
+    for (std::size_t i = 0; i < usableEnts_.size(); ++i) {
+        auto pos = usableEnts_[i].ent->GetCenterPosition();
+        auto cellX = static_cast<i32>(std::floor(pos.x / UsableCellSize));
+        auto cellY = static_cast<i32>(std::floor(pos.y / UsableCellSize));
+
+        usableCells_[GetUsableCellKey(cellX, cellY)].push_back(i);
+    }
+
+    usableCellsVersion_ = usableEntsVersion_;
+    usableCellsValid_ = true;
+}
+
+
+void WorldArea::AddEntityToTypeBucket(Entity& ent)
+{
+    std::type_index type(typeid(ent));
+    std::size_t bucket = 0;
+
+    while (bucket < entTypeBuckets_.size() && entTypeBuckets_[bucket].type != type) {
+        ++bucket;
+    }
+
+    if (bucket == entTypeBuckets_.size()) {
+        entTypeBuckets_.push_back(EntityTypeBucket{type, {}});
+    }
+
+    ent.typeBucket_ = bucket;
+    ent.typeBucketIndex_ = entTypeBuckets_[bucket].ents.size();
+    entTypeBuckets_[bucket].ents.push_back(&ent);
+}
+
+
+void WorldArea::RemoveEntityFromTypeBucket(Entity& ent)
+{
+    auto& ents = entTypeBuckets_[ent.typeBucket_].ents;
+    assert(ent.typeBucketIndex_ < ents.size() && ents[ent.typeBucketIndex_] == &ent);
+
+    // swap the last one into our place
+    ents[ent.typeBucketIndex_] = ents.back();
+    ents[ent.typeBucketIndex_]->typeBucketIndex_ = ent.typeBucketIndex_;
+    ents.pop_back();
+}
+
+
 bool WorldArea::RemoveEntity(EntityId id)
 {
     auto it = ents_.find(id);
@@ -520,10 +1832,15 @@ bool WorldArea::CenterViewOnWorldEntity(EntityId entId)
 }
 
 
+const i64 World::BackgroundTickBudgetMicros;
+
+
 World::World(GameFilesystem& areaFs) :
 debugMode_(false),
 currentArea_(nullptr),
-areaFs_(areaFs)
+areaFs_(areaFs),
+frameCount_(0),
+backgroundBudgetMicros_(0)
 {
 }
 
@@ -533,15 +1850,89 @@ World::~World()
 }
 
 
+World::BackgroundTickInfo& World::AddBackgroundTickInfo(const WorldArea* area)
+{
+    // until an area has ticked in the background, assume it takes a whole frame's budget, so that at most
+    // one area we know nothing about ticks per frame
+    return backgroundTickInfo_.emplace(area, BackgroundTickInfo{0, BackgroundTickBudgetMicros, false}).first->second;
+}
+
+
+void World::TickBackgroundAreas()
+{
+    PROFILE_ZONE("World::TickBackgroundAreas");
+
+    // stalest areas first
+    backgroundTickQueue_.clear();
+
+    for (auto& areaInfo : areas_) {
+        if (areaInfo.second.get() != currentArea_) {
+            AddBackgroundTickInfo(areaInfo.second.get());
+            backgroundTickQueue_.emplace_back(areaInfo.second.get());
+        }
+    }
+
+    if (backgroundTickQueue_.empty()) {
+        return;
+    }
+
+    std::sort(backgroundTickQueue_.begin(), backgroundTickQueue_.end(), [this](WorldArea* a, WorldArea* b) {
+        return backgroundTickInfo_[a].lastTickedFrame < backgroundTickInfo_[b].lastTickedFrame;
+    });
+
+    // the budget refills to a frame's worth, no more, so no frame spends more than that unless a tick
+    // costs more than it was expected to; then the overspend is paid back over the following frames
+    backgroundBudgetMicros_ = std::min(backgroundBudgetMicros_ + BackgroundTickBudgetMicros,
+        BackgroundTickBudgetMicros);
+
+    for (auto area : backgroundTickQueue_) {
+        auto& tickInfo = backgroundTickInfo_[area];
+
+        // an area costing more than a whole frame's budget can never be afforded, so it stays frozen
+        // until the player comes back to it
+        if (tickInfo.tickCostMicros > BackgroundTickBudgetMicros) {
+            continue;
+        }
+
+        // don't skip ahead to cheaper areas, or the expensive ones would never get a turn
+        if (tickInfo.tickCostMicros > backgroundBudgetMicros_) {
+            break;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        area->TickInBackground();
+        auto costMicros = static_cast<i64>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+
+        // smooth the cost estimate so one slow tick doesn't stall the area for long
+        tickInfo.tickCostMicros = tickInfo.measured ? (tickInfo.tickCostMicros * 3 + costMicros) / 4 : costMicros;
+        tickInfo.measured = true;
+        tickInfo.lastTickedFrame = frameCount_;
+
+        backgroundBudgetMicros_ -= costMicros;
+    }
+}
+
+
 void World::Tick()
 {
 	if (currentArea_) {
 		currentArea_->Tick(isPaused_);
 	}
+
+    if (!isPaused_) {
+        ++frameCount_;
+
+        if (currentArea_) {
+            AddBackgroundTickInfo(currentArea_).lastTickedFrame = frameCount_;
+        }
+
+        TickBackgroundAreas();
+    }
 }
 
 
-void World::Render(sf::RenderTarget& target)
+void World::Render(CountingRenderTarget& target)
 {
 	if (currentArea_) {
 		currentArea_->Render(target, debugMode_);
@@ -1,27 +1,41 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
+#include <deque>
+#include <iterator>
+#include <type_traits>
+#include <typeindex>
 #include <unordered_map>
 #include <chrono>
 #include <cinttypes>
+#include <cmath>
 
-#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Shape.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include "Types.h"
+#include "CountingRenderTarget.h"
 #include "Tile.h"
 #include "Entity.h"
 #include "Collision.h"
 #include "GameFilesystem.h"
+#include "PlayerUsable.h"
+#include "Log.h"
+#include "TimerWheel.h"
+#include "NavGraph.h"
 
 /**
 * Represents an area of the game world (a dungeon floor .etc)
 */
 class WorldArea
 {
+    // Entity needs to be able to update the active set, pending deletions & timers
+    friend class Entity;
+
     struct DebugRenderableInfo
     {
     private:
@@ -66,11 +80,283 @@ class WorldArea
 	const u32 w_, h_;
 	const GameFilesystemNode* relatedNode_;
 
-	std::vector<std::unique_ptr<BaseTile>> tiles_;
+    // tiles are stored in square chunks that are only allocated once a tile is written to them,
+    // so memory scales with the carved out part of the area rather than all of it
+    static const u32 TileChunkShift = 4;
+    static const u32 TileChunkSize = 1 << TileChunkShift;
+
+    struct TileChunk
+    {
+        // row-major index of the chunk in the area
+        std::size_t index;
+
+        std::array<std::unique_ptr<BaseTile>, TileChunkSize * TileChunkSize> tiles;
+
+        // chebyshev distance in tiles from each tile to the nearest unwalkable or missing one (or the area's
+        // edge), capped at MaxTileClearance; 0 for unwalkable tiles. tiles of unallocated chunks are missing,
+        // so theirs is 0 too
+        mutable std::array<u8, TileChunkSize * TileChunkSize> clearance;
+    };
+
+    const u32 tileChunksW_, tileChunksH_;
+    std::vector<std::unique_ptr<TileChunk>> tileChunks_;
+    std::vector<TileChunk*> allocatedTileChunks_;
+
+    // clearance is built lazily by the first query after generation & then patched around each changed tile,
+    // or rebuilt if too many changed at once. rebuilds only visit allocated chunks
+    static const u8 MaxTileClearance = 15;
+    static const std::size_t MaxLocalClearanceUpdates = 8;
+
+    mutable std::vector<const TileChunk*> clearanceChunkOrder_;
+    mutable std::vector<u8> clearanceScratch_;
+    mutable std::vector<sf::Vector2u> clearanceDirtyTiles_;
+    mutable bool clearanceNeedsRebuild_;
+
+    // tiles with clearance of at least 1, chunk by chunk; rebuilt from the clearance when next asked for
+    mutable std::vector<sf::Vector2u> walkableTiles_;
+    mutable bool walkableTilesDirty_;
+
+    void MarkTileClearanceDirty(u32 x, u32 y);
+    void SortClearanceChunks() const;
+    void RebuildTileClearance() const;
+    void ComputeTileClearance(u32 boxX, u32 boxY, u32 boxW, u32 boxH,
+        u32 writeX, u32 writeY, u32 writeW, u32 writeH) const;
+
+    // declared before ents_ so it outlives the stats of our ents
+    AliveStatsStore aliveStats_;
 
     EntityId nextEntId_;
     std::unordered_map<EntityId, std::unique_ptr<Entity>> ents_;
 
+    // ents bucketed by their dynamic type, so that typed queries only visit the ents that can match. all of
+    // a bucket's ents match a query type or none do, so it takes one cast per bucket to tell which
+    struct EntityTypeBucket
+    {
+        std::type_index type;
+        std::vector<Entity*> ents;
+    };
+
+    std::vector<EntityTypeBucket> entTypeBuckets_;
+
+    void AddEntityToTypeBucket(Entity& ent);
+    void RemoveEntityFromTypeBucket(Entity& ent);
+
+    // stair & chest ents representing each child fs node of our related node
+    std::unordered_map<const GameFilesystemNode*, EntityId> fsNodeEnts_;
+
+    // PlayerUsable ents; the version changes whenever one is added or removed
+    std::vector<PlayerUsableEntityInfo> usableEnts_;
+    u32 usableEntsVersion_;
+
+    // indices into usableEnts_ bucketed by the UsableCellSize square cell their center is in, keyed by
+    // GetUsableCellKey(). rebuilt by the first range query after the version changes; PlayerUsables are
+    // placed as they're spawned & don't move after, so it doesn't need to follow them in between
+    static const float UsableCellSize;
+
+    mutable std::unordered_map<u64, std::vector<std::size_t>> usableCells_;
+    mutable u32 usableCellsVersion_;
+    mutable bool usableCellsValid_;
+
+    static inline u64 GetUsableCellKey(i32 cellX, i32 cellY)
+    {
+        return (static_cast<u64>(static_cast<u32>(cellX)) << 32) | static_cast<u32>(cellY);
+    }
+
+    void RemoveUsableEntity(PlayerUsable& usable);
+    void UpdateUsableCells() const;
+
+    // ents offering sim LOD tick every frame within SimLodNearDistance of the focus (or further if they ask),
+    // every SimLodMidInterval frames out to SimLodFarDistance & not at all beyond that
+    static const float SimLodNearDistance;
+    static const float SimLodFarDistance;
+    static const float SimLodNearMargin;
+    static const u32 SimLodMidInterval = 4;
+
+    bool hasSimLodFocus_;
+    sf::Vector2f simLodFocus_;
+    std::size_t simLodSkippedCount_;
+
+    bool tickingInBackground_;
+
+    void UpdateSimLod(std::size_t activeCount);
+
+    // ents enrolled to Think() do so every thinkInterval_ ticks or so. those due are run nearest to the sim
+    // LOD focus first (but sooner the longer they're overdue, so that far ones aren't starved) until the
+    // tick's think budget is spent; the rest wait for the next tick. the budget is 0 (unlimited) unless set,
+    // which keeps thinking independent of how fast the machine is, & so runs repeatable
+    static const u32 DefaultThinkInterval = 6;
+    static const u64 DefaultThinkBudgetMicroseconds = 0;
+
+    std::vector<Entity*> thinkers_;
+    std::vector<std::pair<float, Entity*>> thinkQueue_;
+    u32 thinkInterval_;
+    u64 thinkBudgetMicroseconds_;
+    std::size_t thinkCount_;
+    std::size_t deferredThinkCount_;
+
+    void EnrollThinker(Entity& ent);
+    void RunThinks();
+
+    // collision phase; ents on a layer are kept sorted by the left of their padded bounds (re-sorted each
+    // tick, which is cheap as they've barely moved since the last), then swept along x for overlapping pairs
+    static const std::size_t CollisionLayerCount = static_cast<std::size_t>(CollisionLayer::Pickup) + 1;
+
+    // how far ents can move during the tick before their contacts found at the start of it go stale
+    static const float CollisionBoundsMargin;
+
+    // how fast overlapping enemies are pushed apart
+    static const float EnemySeparationSpeed;
+
+    std::array<u8, CollisionLayerCount> collisionLayerMasks_;
+    std::vector<WorldEntity*> collisionEnts_;
+    std::vector<std::pair<WorldEntity*, WorldEntity*>> collisionPairs_;
+    std::vector<WorldEntity*> collisionContacts_;
+    u64 collisionPhase_;
+    bool enemySeparation_;
+
+    void UpdateCollisionPairs();
+    void SeparateEnemies();
+
+    // 8-way breadth-first path distances in tiles over walkable tiles to each player's tile, out to
+    // FlowFieldRadius steps; FlowFieldUnreached elsewhere. rebuilt at the start of a tick only if a player
+    // changed tile or the tiles changed, so that however many enemies chase, each only does a lookup.
+    // nothing further than FlowFieldRadius from a source can be reached, so each source only needs a
+    // FlowFieldWindowSize square window of distances centred on its tile, whatever the size of the area
+    static const u16 FlowFieldRadius = 24;
+    static const u32 FlowFieldWindowSize = 2 * FlowFieldRadius + 1;
+
+    std::vector<u16> flowFieldDist_; // a window per source, in the order of flowFieldSources_
+    std::vector<u32> flowFieldReached_; // window indices in the order reached, so it doubles as the queue
+    std::vector<sf::Vector2u> flowFieldSources_;
+    std::vector<sf::Vector2u> flowFieldSourcesScratch_;
+    bool flowFieldDirty_;
+
+    void UpdateFlowField();
+
+    std::unique_ptr<NavGraph> navGraph_;
+    mutable std::vector<sf::Vector2u> pathTilesScratch_;
+
+    // chasers off the flow field re-find their ChasePath once the target is further than this from its end or
+    // they're further than this from their next waypoint, & move on to the next waypoint within the other
+    static const float ChasePathRepathDistance;
+    static const float ChasePathWaypointReachedDistance;
+
+    // active ents handed to each job of the parallel PrepareTick() phase. PrepareTick() only works out the
+    // move, so with fewer active ents than PrepareTickMinParallelCount the phase runs inline, as handing it
+    // out to the workers would cost more than it saves
+    static const std::size_t PrepareTickGrainSize = 128;
+    static const std::size_t PrepareTickMinParallelCount = 512;
+
+    // ents that get ticked; dormant ones are dropped from this until they're woken
+    std::vector<Entity*> activeEnts_;
+    std::vector<EntityId> pendingDeletions_;
+
+    TimerWheel timers_;
+    std::vector<TimerWheel::Timer> expiredTimers_;
+
+    inline void ActivateEntity(Entity& ent)
+    {
+        if (!ent.inActiveSet_) {
+            ent.inActiveSet_ = true;
+            activeEnts_.emplace_back(&ent);
+        }
+    }
+
+    void ScheduleTimer(EntityId entId, u32 tag, const sf::Time& delay);
+    void FireExpiredTimers();
+
+    struct QueryMatch
+    {
+        void* ent;
+        float distanceSq;
+    };
+
+    // scratch buffers for the ForEach* queries; kept around so steady-state queries don't allocate.
+    // there's one per nesting level as a query's callback may run queries of its own
+    mutable std::deque<std::vector<QueryMatch>> queryScratch_;
+    mutable std::size_t queryDepth_;
+
+    class QueryScratchScope
+    {
+        const WorldArea& area_;
+
+    public:
+        std::vector<QueryMatch>& matches;
+
+        explicit QueryScratchScope(const WorldArea& area) :
+            area_(area),
+            matches(area.AcquireQueryScratch())
+        { }
+
+        ~QueryScratchScope() { --area_.queryDepth_; }
+    };
+
+    inline std::vector<QueryMatch>& AcquireQueryScratch() const
+    {
+        if (queryDepth_ == queryScratch_.size()) {
+            queryScratch_.emplace_back();
+        }
+
+        auto& scratch = queryScratch_[queryDepth_++];
+        scratch.clear();
+        return scratch;
+    }
+
+    template <typename Fn, typename... Args>
+    static inline bool InvokeQueryCallback(std::true_type, Fn& fn, Args&&... args)
+    {
+        fn(std::forward<Args>(args)...);
+        return true;
+    }
+
+    template <typename Fn, typename... Args>
+    static inline bool InvokeQueryCallback(std::false_type, Fn& fn, Args&&... args)
+    {
+        return static_cast<bool>(fn(std::forward<Args>(args)...));
+    }
+
+    /**
+    * Gathers the live ents of type T accepted by filter, then hands each to fn.
+    * Gathering first means fn is free to spawn ents (which may add to the type buckets).
+    */
+    template <typename T, typename Filter, typename Fn>
+    void ForEachMatching(Filter&& filter, Fn&& fn) const
+    {
+        QueryScratchScope scratch(*this);
+
+        for (auto& bucket : entTypeBuckets_) {
+            if (bucket.ents.empty() || !dynamic_cast<T*>(bucket.ents.front())) {
+                continue;
+            }
+
+            for (auto ent : bucket.ents) {
+                if (ent->IsMarkedForDeletion()) {
+                    continue;
+                }
+
+                auto typedEnt = static_cast<T*>(ent);
+                float distanceSq = 0.0f;
+
+                if (filter(*typedEnt, distanceSq)) {
+                    scratch.matches.push_back(QueryMatch{typedEnt, distanceSq});
+                }
+            }
+        }
+
+        for (auto& match : scratch.matches) {
+            auto typedEnt = static_cast<T*>(match.ent);
+
+            // an earlier callback may have removed it
+            if (typedEnt->IsMarkedForDeletion()) {
+                continue;
+            }
+
+            if (!fn(typedEnt, match.distanceSq)) {
+                break;
+            }
+        }
+    }
+
     std::vector<std::unique_ptr<sf::Drawable>> frameUiRenderables_;
 
     sf::View renderView_;
@@ -79,12 +365,56 @@ class WorldArea
     void AddDebugRenderableImpl(const sf::Time& timeToDraw, std::unique_ptr<sf::Drawable> drawable, const std::string& labelString = std::string());
     void AddDebugRenderableImpl(std::unique_ptr<sf::Drawable> drawable, const std::string& labelString = std::string());
 
-    inline std::size_t GetTileIndex(u32 x, u32 y) const { return (y * w_) + x; }
+    inline std::size_t GetTileChunkIndex(u32 x, u32 y) const
+    {
+        return (y >> TileChunkShift) * tileChunksW_ + (x >> TileChunkShift);
+    }
+
+    inline std::size_t GetTileIndexInChunk(u32 x, u32 y) const
+    {
+        return ((y & (TileChunkSize - 1)) << TileChunkShift) + (x & (TileChunkSize - 1));
+    }
+
+    /**
+    * Returns the element for the tile at x, y, or nullptr if its chunk hasn't been allocated.
+    */
+    inline const std::unique_ptr<BaseTile>* FindTileElement(u32 x, u32 y) const
+    {
+        auto& chunk = tileChunks_[GetTileChunkIndex(x, y)];
+        return chunk ? &chunk->tiles[GetTileIndexInChunk(x, y)] : nullptr;
+    }
+
+    inline std::unique_ptr<BaseTile>* FindTileElement(u32 x, u32 y)
+    {
+        auto& chunk = tileChunks_[GetTileChunkIndex(x, y)];
+        return chunk ? &chunk->tiles[GetTileIndexInChunk(x, y)] : nullptr;
+    }
+
+    /**
+    * Reads the clearance of the tile at x, y without bringing it up to date first; 0 outside of the area.
+    */
+    inline u8 ReadTileClearance(i64 x, i64 y) const
+    {
+        if (x < 0 || y < 0 || x >= w_ || y >= h_) {
+            return 0;
+        }
+
+        auto& chunk = tileChunks_[GetTileChunkIndex(static_cast<u32>(x), static_cast<u32>(y))];
+        return chunk ? chunk->clearance[GetTileIndexInChunk(static_cast<u32>(x), static_cast<u32>(y))] : 0;
+    }
+
+    std::unique_ptr<BaseTile>& GetOrCreateTileElement(u32 x, u32 y);
 
-	inline std::unique_ptr<BaseTile>& GetTileElement(u32 x, u32 y) { return tiles_[GetTileIndex(x, y)]; }
-    inline const std::unique_ptr<BaseTile>& GetTileElement(u32 x, u32 y) const { return tiles_[GetTileIndex(x, y)]; }
+    /**
+    * Whether a ray stops at the tile at x, y; unwalkable & missing tiles block, as does anything outside the area.
+    * Reads the clearance field directly, so it must be up to date.
+    */
+    inline bool IsTileBlockingRay(i64 x, i64 y) const
+    {
+        return ReadTileClearance(x, y) == 0;
+    }
 
-    void RenderVignette(sf::RenderTarget& target);
+    void RenderVignette(CountingRenderTarget& target);
 
 public:
 	WorldArea(const GameFilesystemNode* relatedNode, u32 w = 200, u32 h = 200);
@@ -134,6 +464,147 @@ public:
 
     bool CheckRectanglePlaceable(u32 topX, u32 topY, u32 w, u32 h) const;
 
+    /**
+    * Brings the tile clearance field up to date with any tile changes. Queries do this themselves, but
+    * as that writes to the field, it must be done before querying from multiple threads at once.
+    */
+    void UpdateTileClearance() const;
+
+    /**
+    * Returns the chebyshev distance in tiles from x, y to the nearest unwalkable tile, up to
+    * MaxTileClearance. 0 if the tile at x, y is unwalkable. A tile with clearance c is at the center of
+    * a (2c - 1) x (2c - 1) square of walkable tiles.
+    */
+    u8 GetTileClearance(u32 x, u32 y) const;
+
+    /**
+    * Searches outwards from x, y in rings up to maxRadius tiles away for the nearest tile with at least
+    * minClearance. Returns false if there's none.
+    */
+    bool FindNearestClearTile(u32 x, u32 y, u8 minClearance, u32 maxRadius, u32* outX, u32* outY) const;
+
+    /**
+    * Returns the tiles with a clearance of at least 1 (the walkable ones), chunk by chunk, for picking
+    * uniformly random spawn locations from. Building the list brings the clearance up to date; it's
+    * invalidated by the next tile change.
+    */
+    const std::vector<sf::Vector2u>& GetWalkableTiles() const;
+
+    /**
+    * Steps through GetWalkableTiles() from walkableIndex, wrapping around, to the first tile with a
+    * clearance of at least minClearance that accept(x, y) returns true for. Lets spawners take a single
+    * random draw for the starting index rather than retrying random tiles until one fits.
+    * Returns false if there's no such tile.
+    */
+    template <typename Pred>
+    bool FindWalkableTileFrom(std::size_t walkableIndex, u8 minClearance, Pred&& accept,
+        u32* outX, u32* outY) const
+    {
+        auto& walkableTiles = GetWalkableTiles();
+
+        for (std::size_t i = 0; i < walkableTiles.size(); ++i) {
+            const auto& tile = walkableTiles[(walkableIndex + i) % walkableTiles.size()];
+
+            if (GetTileClearance(tile.x, tile.y) >= minClearance && accept(tile.x, tile.y)) {
+                if (outX) {
+                    *outX = tile.x;
+                }
+                if (outY) {
+                    *outY = tile.y;
+                }
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    struct RaycastHit
+    {
+        bool hit;
+
+        // the first blocking tile along the ray (which may be outside of the area) & the point the ray entered
+        // it at. if nothing was hit, the tile is the one the ray ended in & the point is its end
+        i64 tileX, tileY;
+        sf::Vector2f point;
+
+        // how far along the ray point is, from 0 to 1
+        float fraction;
+    };
+
+    struct RaycastQuery
+    {
+        sf::Vector2f from, to;
+    };
+
+    /**
+    * Walks the tiles crossed by the line from -> to in order (Amanatides & Woo's DDA) & stops at the first one
+    * that's unwalkable or missing. Returns true if the line was blocked.
+    * A line starting inside a blocking tile is blocked at its start.
+    */
+    bool Raycast(const sf::Vector2f& from, const sf::Vector2f& to, RaycastHit* outHit = nullptr) const;
+    inline bool HasLineOfSight(const sf::Vector2f& from, const sf::Vector2f& to) const
+    {
+        return !Raycast(from, to);
+    }
+
+    /**
+    * Raycast()s each of queries, writing the results to the same index of outHits. The rays are cast grouped
+    * by the tile chunk they start in, so the tiles (& their clearance) they cross are more likely to still be
+    * in cache. The ray order goes in a per thread scratch buffer, so batches may be cast from several threads
+    * as long as no tiles have changed since the clearance was last brought up to date.
+    */
+    void RaycastBatch(const RaycastQuery* queries, std::size_t count, RaycastHit* outHits) const;
+
+    static const u16 FlowFieldUnreached = 0xffff;
+
+    /**
+    * Path distance in tiles from the tile at x, y (or containing pos) to the nearest player's along the
+    * flow field, or FlowFieldUnreached if it's further than FlowFieldRadius or there's no path.
+    */
+    u16 GetFlowFieldDistance(u32 x, u32 y) const;
+    u16 GetFlowFieldDistance(const sf::Vector2f& pos) const;
+
+    /**
+    * Unit direction for something at pos to head in to follow the flow field to the nearest player; towards
+    * the center of the neighbouring tile closest to them. Returns false if pos is off the field or already
+    * on a player's tile.
+    */
+    bool GetFlowFieldDirection(const sf::Vector2f& pos, WorldVector* outDir) const;
+
+    /**
+    * Unit direction to chase a player at to from from; along the flow field where it reaches, else along path
+    * (found with FindPath() as needed) if given, else straight. Must only be called from one thread at a time
+    * if path is given.
+    */
+    WorldVector GetChaseDirection(const sf::Vector2f& from, const sf::Vector2f& to, ChasePath* path = nullptr) const;
+
+    /**
+    * Sets the graph of this area's rooms & passages that FindPath() searches; normally from the generator.
+    */
+    inline void SetNavGraph(std::unique_ptr<NavGraph>&& navGraph) { navGraph_ = std::move(navGraph); }
+    inline const NavGraph* GetNavGraph() const { return navGraph_.get(); }
+
+    /**
+    * Finds a path across the area from from to to over the nav graph, writing the centers of the tiles to
+    * walk through to outWaypoints (ending with to's). Returns false if there's no nav graph or no path.
+    * Must only be called from one thread at a time.
+    */
+    bool FindPath(const sf::Vector2f& from, const sf::Vector2f& to, std::vector<sf::Vector2f>* outWaypoints) const;
+
+    /**
+    * Sweeps the rectangle r along displacement d through the tiles, & returns the fraction of d it can move
+    * before running into an unwalkable or missing tile (1.0f if it can move all of it). Unlike
+    * TryCollisionRectMove(), the tiles are checked along the true path rather than in x then y, so nothing
+    * is skipped or clipped on corners however far r moves.
+    *
+    * outNormal is written with the normal of the tile face hit (zeroed if none), & outTileX & outTileY with
+    * the position of that tile.
+    */
+    float SweepRectThroughTiles(const sf::FloatRect& r, const sf::Vector2f& d, sf::Vector2f* outNormal = nullptr,
+        i64* outTileX = nullptr, i64* outTileY = nullptr) const;
+
     bool CheckRectangleWalkable(u32 topX, u32 topY, u32 w, u32 h) const;
     inline bool CheckEntRectangleWalkable(const sf::FloatRect& rect) const
     {
@@ -161,6 +632,12 @@ public:
     bool TryCollisionRectMove(const sf::FloatRect& r, const sf::Vector2f& d, sf::Vector2f* outEndPos,
         BaseTile** outCollidedTile = nullptr, u32* outCollidedTileX = nullptr, u32* outCollidedTileY = nullptr);
 
+    /**
+    * TryCollisionRectMove() in 16.16 fixed point; only integer maths is used, so the result is bit-identical
+    * on every build. Where several tiles are hit along an axis, r stops at the nearest.
+    */
+    bool TryCollisionRectMoveFixed(const FixedRect& r, const FixedVector2& d, FixedVector2* outEndPos) const;
+
     template <typename T>
     EntityId AddEntity(std::unique_ptr<T>&& ent)
     {
@@ -181,10 +658,35 @@ public:
             return Entity::InvalidId;
         }
 
-        std::cout << "Adding new ent " << ent->GetName() << " (ent id " << nextEntId_ << ")\n";
+        LOG_DEBUG("Adding new ent {} (ent id {})", ent->GetName(), nextEntId_);
         ent->assignedArea_ = this;
         ent->assignedId_ = nextEntId_;
+
+        if (ent->IsMarkedForDeletion()) {
+            pendingDeletions_.emplace_back(nextEntId_);
+        }
+        else if (!ent->IsDormant()) {
+            ActivateEntity(*ent);
+        }
+
+        Entity* entPtr = ent.get();
         ents_.emplace(nextEntId_, std::move(ent));
+        AddEntityToTypeBucket(*entPtr);
+
+        auto usableEnt = dynamic_cast<PlayerUsable*>(entPtr);
+        auto worldEnt = dynamic_cast<WorldEntity*>(entPtr);
+
+        if (usableEnt && worldEnt) {
+            usableEnt->usableIndex_ = usableEnts_.size();
+            usableEnts_.push_back(PlayerUsableEntityInfo{nextEntId_, worldEnt, usableEnt});
+            ++usableEntsVersion_;
+        }
+
+        if (worldEnt && worldEnt->GetCollisionLayer() != CollisionLayer::None) {
+            collisionEnts_.push_back(worldEnt);
+        }
+
+        entPtr->OnAssignedToArea();
 
         return nextEntId_++;
     }
@@ -198,7 +700,14 @@ public:
     bool RemoveEntity(EntityId id);
 
 	void Tick(bool paused = false);
-	void Render(sf::RenderTarget& target, bool renderDebug = false);
+	void Render(CountingRenderTarget& target, bool renderDebug = false);
+
+    /**
+    * Ticks the area while the player is elsewhere. Everything ticks at full rate as there's
+    * no player to measure sim LOD from.
+    */
+    void TickInBackground();
+    inline bool IsTickingInBackground() const { return tickingInBackground_; }
 
 	BaseTile* GetTile(u32 x, u32 y);
     const BaseTile* GetTile(u32 x, u32 y) const;
@@ -234,13 +743,147 @@ public:
     }
 
     /**
-    * Returns a vector of pairs containing EntityId in range along with their squared distance away
-    * from pos as a float.
+    * Calls fn(T* ent, float distanceSq) for each ent of type T within maxDistance of pos.
+    * fn may return false to stop early. Ents must be removed with MarkForDeletion() from within fn.
     */
-    template <typename T = WorldEntity>
-    std::vector<std::pair<EntityId, float>> GetWorldEntitiesInRange(const sf::Vector2f& pos, float maxDistance) const
+    template <typename T = WorldEntity, typename Fn>
+    void ForEachInRange(const sf::Vector2f& pos, float maxDistance, Fn&& fn)
+    {
+        auto maxDistanceSq = maxDistance * maxDistance;
+
+        ForEachMatching<T>([&pos, maxDistanceSq](T& ent, float& outDistanceSq) {
+            auto entPos = ent.GetCenterPosition();
+            outDistanceSq = (entPos.x - pos.x) * (entPos.x - pos.x) + (entPos.y - pos.y) * (entPos.y - pos.y);
+            return outDistanceSq <= maxDistanceSq;
+        }, [&fn](T* ent, float distanceSq) {
+            return InvokeQueryCallback(std::is_void<decltype(fn(ent, distanceSq))>(), fn, ent, distanceSq);
+        });
+    }
+
+    /**
+    * Calls fn(T* ent) for each ent of type T intersecting rect.
+    * fn may return false to stop early. Ents must be removed with MarkForDeletion() from within fn.
+    */
+    template <typename T = WorldEntity, typename Fn>
+    void ForEachInRect(const sf::FloatRect& rect, Fn&& fn)
+    {
+        ForEachMatching<T>([&rect](T& ent, float&) {
+            return rect.intersects(ent.GetRectangle());
+        }, [&fn](T* ent, float) {
+            return InvokeQueryCallback(std::is_void<decltype(fn(ent))>(), fn, ent);
+        });
+    }
+
+    /**
+    * Calls fn(T* other) for each ent of type T intersecting rect, like ForEachInRect(rect, fn), but only looks
+    * at the contacts the collision phase found for ent this tick; rect should be somewhere about ent (e.g. the
+    * region it's about to move through). Ents on layers that don't collide with ent's are skipped.
+    * Falls back to ForEachInRect() if ent wasn't in the collision phase or rect is outside of its bounds.
+    */
+    template <typename T = WorldEntity, typename Fn>
+    void ForEachContactInRect(WorldEntity& ent, const sf::FloatRect& rect, Fn&& fn)
+    {
+        auto& bounds = ent.collisionBounds_;
+
+        if (ent.GetAssignedArea() != this || ent.contactsPhase_ != collisionPhase_ ||
+            rect.left < bounds.left || rect.top < bounds.top ||
+            rect.left + rect.width > bounds.left + bounds.width || rect.top + rect.height > bounds.top + bounds.height) {
+            ForEachInRect<T>(rect, std::forward<Fn>(fn));
+            return;
+        }
+
+        QueryScratchScope scratch(*this);
+
+        for (std::size_t i = ent.contactsBegin_; i < ent.contactsBegin_ + ent.contactsCount_; ++i) {
+            auto other = collisionContacts_[i];
+
+            if (other->IsMarkedForDeletion()) {
+                continue;
+            }
+
+            auto typedOther = dynamic_cast<T*>(other);
+
+            if (typedOther && rect.intersects(other->GetRectangle())) {
+                scratch.matches.push_back(QueryMatch{typedOther, 0.0f});
+            }
+        }
+
+        for (auto& match : scratch.matches) {
+            auto typedOther = static_cast<T*>(match.ent);
+
+            // an earlier callback may have removed it
+            if (typedOther->IsMarkedForDeletion()) {
+                continue;
+            }
+
+            if (!InvokeQueryCallback(std::is_void<decltype(fn(typedOther))>(), fn, typedOther)) {
+                break;
+            }
+        }
+    }
+
+    /**
+    * Calls fn(T* other) for each ent of type T touching ent. See ForEachContactInRect().
+    */
+    template <typename T = WorldEntity, typename Fn>
+    inline void ForEachTouching(WorldEntity& ent, Fn&& fn)
+    {
+        ForEachContactInRect<T>(ent, ent.GetRectangle(), std::forward<Fn>(fn));
+    }
+
+    /**
+    * Sets whether ents on layer a collide with those on layer b (& vice versa).
+    */
+    void SetLayersCollide(CollisionLayer a, CollisionLayer b, bool collide);
+    inline bool DoLayersCollide(CollisionLayer a, CollisionLayer b) const
+    {
+        return (collisionLayerMasks_[static_cast<std::size_t>(a)] & (1u << static_cast<u32>(b))) != 0;
+    }
+
+    /**
+    * How many ticks enrolled ents wait between Think()s (at least 1), & how long all of the Think()s of a
+    * tick may take in total before the rest are put off to the next (0 for no limit).
+    */
+    inline void SetThinkInterval(u32 ticks) { thinkInterval_ = std::max<u32>(1, ticks); }
+    inline u32 GetThinkInterval() const { return thinkInterval_; }
+    inline void SetThinkBudget(u64 microseconds) { thinkBudgetMicroseconds_ = microseconds; }
+    inline u64 GetThinkBudget() const { return thinkBudgetMicroseconds_; }
+
+    /**
+    * Whether enemies overlapping each other are gradually pushed apart during the collision phase.
+    */
+    inline void SetEnemySeparation(bool enabled) { enemySeparation_ = enabled; }
+    inline bool IsEnemySeparationEnabled() const { return enemySeparation_; }
+
+    /**
+    * Pairs of ents on colliding layers whose bounds (padded by CollisionBoundsMargin) overlapped at the
+    * start of this tick. The ents of each pair may not actually be touching.
+    */
+    inline const std::vector<std::pair<WorldEntity*, WorldEntity*>>& GetCollisionPairs() const
+    {
+        return collisionPairs_;
+    }
+
+    /**
+    * Calls fn(T* ent) for each ent of type T.
+    * fn may return false to stop early. Ents must be removed with MarkForDeletion() from within fn.
+    */
+    template <typename T, typename Fn>
+    void ForEachOfType(Fn&& fn)
+    {
+        ForEachMatching<T>([](T&, float&) {
+            return true;
+        }, [&fn](T* ent, float) {
+            return InvokeQueryCallback(std::is_void<decltype(fn(ent))>(), fn, ent);
+        });
+    }
+
+    /**
+    * Writes a pair of the EntityId & squared distance from pos of each ent of type T in range to out.
+    */
+    template <typename T = WorldEntity, typename OutputIt>
+    OutputIt GetWorldEntitiesInRange(const sf::Vector2f& pos, float maxDistance, OutputIt out) const
     {
-        std::vector<std::pair<EntityId, float>> result;
         auto maxDistanceSq = maxDistance * maxDistance;
 
         for (auto& entInfo : ents_) {
@@ -261,19 +904,29 @@ public:
 
                 auto distanceSq = aSq + bSq;
                 if (distanceSq <= maxDistanceSq) {
-                    result.emplace_back(entInfo.first, distanceSq);
+                    *out++ = std::make_pair(entInfo.first, distanceSq);
                 }
             }
         }
 
-        return result;
+        return out;
     }
 
+    /**
+    * Returns a vector of pairs containing EntityId in range along with their squared distance away
+    * from pos as a float.
+    */
     template <typename T = WorldEntity>
-    std::vector<EntityId> GetAllWorldEntsInRectangle(const sf::FloatRect& rect) const
+    std::vector<std::pair<EntityId, float>> GetWorldEntitiesInRange(const sf::Vector2f& pos, float maxDistance) const
     {
-        std::vector<EntityId> result;
+        std::vector<std::pair<EntityId, float>> result;
+        GetWorldEntitiesInRange<T>(pos, maxDistance, std::back_inserter(result));
+        return result;
+    }
 
+    template <typename T = WorldEntity, typename OutputIt>
+    OutputIt GetAllWorldEntsInRectangle(const sf::FloatRect& rect, OutputIt out) const
+    {
         for (auto& entInfo : ents_) {
             auto& ent = entInfo.second;
             assert(ent);
@@ -285,10 +938,18 @@ public:
             auto worldEnt = dynamic_cast<T*>(ent.get());
 
             if (worldEnt && !worldEnt->IsMarkedForDeletion() && rect.intersects(worldEnt->GetRectangle())) {
-                result.emplace_back(entInfo.first);
+                *out++ = entInfo.first;
             }
         }
 
+        return out;
+    }
+
+    template <typename T = WorldEntity>
+    std::vector<EntityId> GetAllWorldEntsInRectangle(const sf::FloatRect& rect) const
+    {
+        std::vector<EntityId> result;
+        GetAllWorldEntsInRectangle<T>(rect, std::back_inserter(result));
         return result;
     }
 
@@ -313,13 +974,12 @@ public:
         return Entity::InvalidId;
     }
 
-    template <typename T>
-    std::vector<EntityId> GetAllEntitiesOfType() const
+    template <typename T, typename OutputIt>
+    OutputIt GetAllEntitiesOfType(OutputIt out) const
     {
         static_assert(!std::is_same<T, Entity>::value,
             "GetAllEntitiesOfType<T>() - T is of type Entity; use GetAllEntities() instead.");
 
-        std::vector<EntityId> result;
 
         for (auto& entInfo : ents_) {
             auto& ent = entInfo.second;
@@ -330,10 +990,18 @@ public:
             }
 
             if (dynamic_cast<T*>(ent.get())) {
-                result.emplace_back(entInfo.first);
+                *out++ = entInfo.first;
             }
         }
 
+        return out;
+    }
+
+    template <typename T>
+    std::vector<EntityId> GetAllEntitiesOfType() const
+    {
+        std::vector<EntityId> result;
+        GetAllEntitiesOfType<T>(std::back_inserter(result));
         return result;
     }
 
@@ -356,21 +1024,114 @@ public:
         return Entity::InvalidId;
     }
 
-    inline std::vector<EntityId> GetAllEntities() const
+    template <typename OutputIt>
+    OutputIt GetAllEntities(OutputIt out) const
     {
-        std::vector<EntityId> result;
-
         for (auto& entInfo : ents_) {
             assert(entInfo.second);
 
             if (!entInfo.second->IsMarkedForDeletion()) {
-                result.emplace_back(entInfo.first);
+                *out++ = entInfo.first;
             }
         }
 
+        return out;
+    }
+
+    inline std::vector<EntityId> GetAllEntities() const
+    {
+        std::vector<EntityId> result;
+        GetAllEntities(std::back_inserter(result));
         return result;
     }
 
+    /**
+    * Writes the PlayerUsableEntityInfo of each PlayerUsable ent within maxDistance of pos to out.
+    * Only the PlayerUsables in the cells overlapping the range are looked at, so this is much cheaper than
+    * GetWorldEntitiesInRange(). The pointers written stay valid while GetUsableEntitiesVersion() is unchanged.
+    */
+    template <typename OutputIt>
+    OutputIt GetUsableEntitiesInRange(const sf::Vector2f& pos, float maxDistance, OutputIt out) const
+    {
+        UpdateUsableCells();
+
+        auto maxDistanceSq = maxDistance * maxDistance;
+        auto minCellX = static_cast<i32>(std::floor((pos.x - maxDistance) / UsableCellSize));
+        auto minCellY = static_cast<i32>(std::floor((pos.y - maxDistance) / UsableCellSize));
+        auto maxCellX = static_cast<i32>(std::floor((pos.x + maxDistance) / UsableCellSize));
+        auto maxCellY = static_cast<i32>(std::floor((pos.y + maxDistance) / UsableCellSize));
+
+        for (auto cellY = minCellY; cellY <= maxCellY; ++cellY) {
+            for (auto cellX = minCellX; cellX <= maxCellX; ++cellX) {
+                auto it = usableCells_.find(GetUsableCellKey(cellX, cellY));
+                if (it == usableCells_.end()) {
+                    continue;
+                }
+
+                for (auto index : it->second) {
+                    auto& usableInfo = usableEnts_[index];
+                    if (usableInfo.ent->IsMarkedForDeletion()) {
+                        continue;
+                    }
+
+                    auto entPos = usableInfo.ent->GetCenterPosition();
+                    auto distanceSq = (entPos.x - pos.x) * (entPos.x - pos.x) + (entPos.y - pos.y) * (entPos.y - pos.y);
+
+                    if (distanceSq <= maxDistanceSq) {
+                        *out++ = usableInfo;
+                    }
+                }
+            }
+        }
+
+        return out;
+    }
+
+    inline u32 GetUsableEntitiesVersion() const { return usableEntsVersion_; }
+
+    /**
+    * Associates the ent representing a child fs node of this area (its stairs or chest) with that node.
+    */
+    inline void SetFsNodeEntity(const GameFilesystemNode* node, EntityId entId) { fsNodeEnts_[node] = entId; }
+
+    /**
+    * Returns the ent representing the given child fs node, or nullptr if there
+    * isn't one of type T.
+    */
+    template <typename T = Entity>
+    T* GetFsNodeEntity(const GameFilesystemNode* node)
+    {
+        auto it = fsNodeEnts_.find(node);
+        if (it == fsNodeEnts_.end()) {
+            return nullptr;
+        }
+
+        return dynamic_cast<T*>(GetEntity(it->second));
+    }
+
+    /**
+    * Sets the position (normally the player's) that sim LOD tiers are measured from.
+    * Without one, every ent ticks at full rate.
+    */
+    inline void SetSimLodFocus(const sf::Vector2f& pos)
+    {
+        hasSimLodFocus_ = true;
+        simLodFocus_ = pos;
+    }
+
+    inline void ClearSimLodFocus() { hasSimLodFocus_ = false; }
+
+    inline std::size_t GetEntityCount() const { return ents_.size(); }
+    inline std::size_t GetAllocatedTileChunkCount() const { return allocatedTileChunks_.size(); }
+    inline std::size_t GetActiveEntityCount() const { return activeEnts_.size(); }
+    inline std::size_t GetSimLodSkippedCount() const { return simLodSkippedCount_; }
+    inline std::size_t GetThinkCount() const { return thinkCount_; }
+    inline std::size_t GetDeferredThinkCount() const { return deferredThinkCount_; }
+    inline std::size_t GetPendingTimerCount() const { return timers_.GetPendingCount(); }
+
+    inline AliveStatsStore& GetAliveStatsStore() { return aliveStats_; }
+    inline const AliveStatsStore& GetAliveStatsStore() const { return aliveStats_; }
+
     bool CenterViewOnWorldEntity(EntityId entId);
     inline sf::View& GetRenderView() { return renderView_; }
 
@@ -385,6 +1146,16 @@ public:
 */
 class World
 {
+    // CPU time per frame spent ticking areas other than the current one
+    static const i64 BackgroundTickBudgetMicros = 1000;
+
+    struct BackgroundTickInfo
+    {
+        u64 lastTickedFrame;
+        i64 tickCostMicros;
+        bool measured; // whether tickCostMicros is from an actual background tick yet
+    };
+
     bool debugMode_;
     bool isPaused_;
 
@@ -394,12 +1165,20 @@ class World
 	WorldArea* currentArea_;
     std::string currentAreaFsPath_;
 
+    u64 frameCount_;
+    i64 backgroundBudgetMicros_;
+    std::unordered_map<const WorldArea*, BackgroundTickInfo> backgroundTickInfo_;
+    std::vector<WorldArea*> backgroundTickQueue_;
+
+    BackgroundTickInfo& AddBackgroundTickInfo(const WorldArea* area);
+    void TickBackgroundAreas();
+
 public:
     World(GameFilesystem& areaFs);
 	~World();
 
 	void Tick();
-	void Render(sf::RenderTarget& target);
+	void Render(CountingRenderTarget& target);
 
     /**
     * Returns true if successfully loaded or already loaded. False otherwise.
@@ -1,5 +1,7 @@
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -8,19 +10,124 @@
 #endif
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Window/Event.hpp>
 
 #include "Game.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+
+
+namespace
+{
+    /**
+    * Parses the u32 value following argv[i] into outValue, advancing i.
+    */
+    bool ParseU32Argument(int argc, char* argv[], int& i, u32& outValue)
+    {
+        if (i + 1 >= argc) {
+            std::cerr << "WARN - Missing value for argument '" << argv[i] << "'\n";
+            return false;
+        }
+
+        outValue = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        return true;
+    }
+
+
+    void PrintReports(bool reportAllocs, bool reportStress)
+    {
+        // get queued log messages out of the way first so they don't interleave with the reports
+        Logger::Get().Flush();
+
+        if (Game::Get().IsReportingDraws()) {
+            Game::Get().PrintDrawReport();
+        }
+
+        if (reportAllocs) {
+            Profiler::Get().PrintTopAllocatingZones();
+        }
+
+        if (reportStress) {
+            Game::Get().GetStressScene().PrintReport();
+            Logger::Get().Flush();
+        }
+    }
+}
 
 
 int main(int argc, char* argv[])
 {
-    sf::RenderWindow window(sf::VideoMode(1024, 768), "The File System Dungeon - Loading...");
+    bool reportAllocs = false;
+    bool headless = false;
+
+    u32 stressEnemies = 0;
+    u32 stressProjectileStreams = 0;
+    bool stressGuardianVolleys = false;
+    u32 stressFrames = 0;
+
+    auto jobWorkers = static_cast<u32>(JobSystem::GetDefaultWorkerCount());
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--report-draws") == 0) {
+            // draw counts are for benchmark runs, so render offscreen as fast as possible
+            Game::Get().SetReportDraws(true);
+            headless = true;
+        }
+        else if (std::strcmp(argv[i], "--report-allocs") == 0) {
+            reportAllocs = true;
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        else if (std::strcmp(argv[i], "--stress-enemies") == 0) {
+            ParseU32Argument(argc, argv, i, stressEnemies);
+        }
+        else if (std::strcmp(argv[i], "--stress-projectiles") == 0) {
+            ParseU32Argument(argc, argv, i, stressProjectileStreams);
+        }
+        else if (std::strcmp(argv[i], "--stress-volleys") == 0) {
+            stressGuardianVolleys = true;
+        }
+        else if (std::strcmp(argv[i], "--stress-frames") == 0) {
+            ParseU32Argument(argc, argv, i, stressFrames);
+        }
+        else if (std::strcmp(argv[i], "--jobs") == 0) {
+            // 0 runs everything on the game thread
+            ParseU32Argument(argc, argv, i, jobWorkers);
+        }
+        else {
+            std::cerr << "WARN - Unknown argument '" << argv[i] << "'\n";
+        }
+    }
+
+    JobSystem::Get().Start(jobWorkers);
+
+    bool stressRun = stressEnemies > 0 || stressProjectileStreams > 0 || stressGuardianVolleys;
+    if ((stressRun || headless) && stressFrames == 0) {
+        stressFrames = 600;
+    }
+
+    // headless runs render offscreen as fast as possible
+    std::unique_ptr<sf::RenderWindow> window;
+    std::unique_ptr<sf::RenderTexture> offscreenTarget;
+
+    if (headless) {
+        offscreenTarget = std::make_unique<sf::RenderTexture>();
+        if (!offscreenTarget->create(1024, 768)) {
+            std::cerr << "ERROR - Failed to create offscreen render target! Exiting\n";
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        window = std::make_unique<sf::RenderWindow>(sf::VideoMode(1024, 768), "The File System Dungeon - Loading...");
 
-    const auto targetFrameRate = static_cast<unsigned int>(
-        std::roundf(1000000.0f / Game::FrameTimeStep.asMicroseconds())
-        );
-	window.setFramerateLimit(targetFrameRate);
+        const auto targetFrameRate = static_cast<unsigned int>(
+            std::roundf(1000000.0f / Game::FrameTimeStep.asMicroseconds())
+            );
+        window->setFramerateLimit(targetFrameRate);
+    }
 
     if (!GameAssets::Get().LoadAssets()) {
         std::cerr << "ERROR - Failed to load game assets! Exiting\n";
@@ -32,15 +139,39 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-    window.setTitle("The File System Dungeon");
+    // only interactive play trades repeatable thinking for a steady frame rate; headless & stress runs
+    // are compared against each other, so they keep it unlimited
+    if (!headless && !stressRun) {
+        Game::Get().SetThinkBudget(1000);
+    }
+
+    if (stressRun) {
+        // ramp up in 10 steps over the run so the report shows how the load scales
+        Game::Get().ScheduleNewGame();
+        Game::Get().GetStressScene().StartRamp(stressEnemies, stressProjectileStreams, stressGuardianVolleys,
+            10, stressFrames / 10);
+    }
+
+    if (headless) {
+        for (u32 frame = 0; frame < stressFrames; ++frame) {
+            Game::Get().RunFrame(*offscreenTarget);
+            offscreenTarget->display();
+        }
+
+        PrintReports(reportAllocs, stressRun);
+        return EXIT_SUCCESS;
+    }
+
+    window->setTitle("The File System Dungeon");
+    u32 frameCount = 0;
 
-	while (window.isOpen()) {
+	while (window->isOpen()) {
 		// handle window events
 		sf::Event event;
-		while (window.pollEvent(event)) {
+		while (window->pollEvent(event)) {
 			switch (event.type) {
 			case sf::Event::Closed:
-				window.close();
+				window->close();
 				break;
 
             case sf::Event::KeyPressed:
@@ -57,16 +188,22 @@ int main(int argc, char* argv[])
 		}
 
         // automatically pause if window not in focus
-        if (!window.hasFocus() && !Game::Get().IsPaused()) {
+        if (!stressRun && !window->hasFocus() && !Game::Get().IsPaused()) {
             std::cout << "Window lost focus - pausing game\n";
             Game::Get().SetPaused(true);
         }
 
 		// game loop
-        Game::Get().RunFrame(window);
-		window.display();
+        Game::Get().RunFrame(*window);
+		window->display();
+
+        if (stressRun && ++frameCount >= stressFrames) {
+            window->close();
+        }
 	}
 
+    PrintReports(reportAllocs, stressRun);
+
     std::cout << "Exiting game\n";
     return EXIT_SUCCESS;
 }